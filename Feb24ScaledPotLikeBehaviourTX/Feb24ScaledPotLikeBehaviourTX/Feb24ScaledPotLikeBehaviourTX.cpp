@@ -85,53 +85,20 @@ static constexpr int OLED_RESET = -1;
 Adafruit_SSD1306 display(OLED_W, OLED_H, &Wire, OLED_RESET);
 
 // ============================================================================
-// PROTOCOL (v2, matches RX)
+// PROTOCOL (v2, include/TbProtocol.h — shared with the RX)
 // ============================================================================
-static constexpr uint8_t TB_MAX_AIR = 32;
-static constexpr uint8_t TB_VER     = 2;
-
-enum TbMsgType : uint8_t { TB_CMD = 1, TB_PING = 2, TB_ACK = 4 };
-enum TbStatus  : uint8_t { TB_S_OK = 0, TB_S_BAD_VER = 1, TB_S_BAD_LEN = 2, TB_S_BAD_CRC = 3, TB_S_BAD_TYPE = 4 };
-
-#pragma pack(push, 1)
-struct TbHdr {
-  uint8_t ver;
-  uint8_t type;
-  uint8_t flags;
-  uint8_t seq;
-  uint8_t len;
-};
-
-struct TbCmdV1 {
-  int8_t  throttlePct;   // -100..100
-  int8_t  rudderPct;     // -100..100
-  uint8_t acc[4];        // 0..255
-  uint8_t arm;           // 0/1
-};
-
-struct TbAckV2 {
-  uint8_t  ver;
-  uint8_t  type;     // TB_ACK
-  uint8_t  seqEcho;
-  uint8_t  status;
-  uint16_t rxOk;
-  uint16_t rxBad;
+#define TB_CRC_BACKEND 3   // 0 = bitwise, 1 = table256, 2 = nibble, 3 = slice4 (see TbCrc16Ccitt)
+#define TB_CRC_BENCH   0   // 1 = print CRC backend cycles/byte at boot
+#define TB_CMD_COMPACT 1   // 1 = send compact delta CMD frames (TB_CMDC), 0 = full v2 TB_CMD frames
+#define TB_HOP         1   // 1 = frequency hopping (must match RX), 0 = fixed RF_CHANNEL
+#define TB_HOP_SIM     0   // 1 = run the hop/interferer simulation at boot
+#define TB_TEL_BOXCAR  0   // 1 = OLED shows the 10 s boxcar average, 0 = RX-filtered values as received
+#define TB_RTT         1   // 1 = stamp the first CMD every TB_RTT_PERIOD_MS with a micros() token (RTT / one-way / jitter)
+#define TB_TX_ASYNC    1   // 1 = startWrite + STATUS polling, tick() never waits out auto-retransmits; 0 = blocking radio.write()
 
-  uint16_t vSys_mV;
-  uint16_t vProp_mV;
-  uint16_t iSys_mA;
-
-  int16_t  tMotor_cC;
-  int16_t  tEsc_cC;
-  uint16_t waterRaw;
-
-  uint16_t crc16;
-};
-#pragma pack(pop)
+#include "TbProtocol.h"
 
-static constexpr uint8_t TB_HDR_LEN = sizeof(TbHdr);
-static constexpr uint8_t TB_CRC_LEN = 2;
-static constexpr uint8_t TB_MAX_PAY = (uint8_t)(TB_MAX_AIR - TB_HDR_LEN - TB_CRC_LEN);
+static const char* const kFsStageNames[] = { "OK", "HOLD", "RAMP", "NEUTRAL" };
 
 // ============================================================================
 // UTIL
@@ -151,21 +118,44 @@ static void logBothf(const char* fmt, ...) {
   Serial.println(buf);
 }
 
-// CRC16-CCITT (0x1021), init 0xFFFF
-static uint16_t TbCrc16Ccitt(const uint8_t* data, size_t len) {
-  uint16_t crc = 0xFFFF;
-  for (size_t i = 0; i < len; i++) {
-    crc ^= (uint16_t)data[i] << 8;
-    for (uint8_t b = 0; b < 8; b++) {
-      crc = (crc & 0x8000) ? (uint16_t)((crc << 1) ^ 0x1021) : (uint16_t)(crc << 1);
-    }
-  }
-  return crc;
+static const char* TbLinkLevelName(uint8_t level) {
+  static const char* const names[TB_LINK_LEVELS] = {
+    "250k/MAX", "250k/HIGH", "250k/LOW", "250k/MIN", "1M/LOW", "2M/LOW", "2M/MIN"
+  };
+  return (level < TB_LINK_LEVELS) ? names[level] : "?";
 }
 
-static uint16_t TbAckCrc(const TbAckV2& a) {
-  return TbCrc16Ccitt((const uint8_t*)&a, sizeof(TbAckV2) - sizeof(uint16_t));
+#if TB_CRC_BENCH
+// Boot-time CRC benchmark: cycles/byte per backend (CPU cycle counter) + equivalence check
+static void TbCrcBenchmark() {
+  uint8_t buf[TB_MAX_AIR];
+  for (uint8_t i = 0; i < sizeof(buf); i++) buf[i] = (uint8_t)(i * 37 + 11);
+
+  struct Backend { const char* name; uint16_t (*fn)(const uint8_t*, size_t); };
+  const Backend backends[] = {
+    { "bitwise ", TbCrc16Bitwise },
+    { "table256", TbCrc16Table256 },
+    { "nibble  ", TbCrc16Nibble },
+    { "slice4  ", TbCrc16Slice4 },
+  };
+
+  static constexpr uint32_t RUNS = 1000;
+  const uint16_t ref = TbCrc16Bitwise(buf, sizeof(buf));
+
+  for (const Backend& b : backends) {
+    const uint16_t got = b.fn(buf, sizeof(buf)); // also builds slice4 tables before timing
+    volatile uint16_t sink = 0;
+    const uint32_t c0 = ESP.getCycleCount();
+    for (uint32_t r = 0; r < RUNS; r++) sink ^= b.fn(buf, sizeof(buf));
+    const uint32_t cycles = ESP.getCycleCount() - c0;
+    (void)sink;
+
+    logBothf("CRC %s: %.1f cyc/B  %s", b.name,
+             (double)cycles / ((double)RUNS * sizeof(buf)),
+             got == ref ? "OK" : "MISMATCH");
+  }
 }
+#endif
 
 static bool TbBuildFrame(uint8_t type, uint8_t flags, uint8_t seq,
                          const uint8_t* payload, uint8_t payLen,
@@ -193,6 +183,79 @@ static bool TbBuildFrame(uint8_t type, uint8_t flags, uint8_t seq,
   return true;
 }
 
+// Compact delta CMD encoder. acc[] is carried until a frame holding it is
+// auto-acked; a keyframe (acc[] included whether it changed or not) goes out
+// every KEY_EVERY acked frames and right after any failed write so the RX
+// resyncs after loss.
+class TbCmdCompactEncoder {
+public:
+  void reset() {
+    memset(_acc, 0, sizeof(_acc));
+    _accDirty = false;
+    _keyDue = true;
+    _sinceKey = 0;
+    _lastKey = false;
+    _lastWithAcc = false;
+  }
+
+  uint8_t encode(const TbCmdV1& cmd, uint8_t seq, uint8_t* out, bool stamp = false, uint32_t token = 0) {
+    if (memcmp(_acc, cmd.acc, TB_CMDC_ACC_LEN) != 0) {
+      memcpy(_acc, cmd.acc, TB_CMDC_ACC_LEN);
+      _accDirty = true;
+    }
+
+    _lastKey = _keyDue || _sinceKey >= KEY_EVERY;
+    _lastWithAcc = _lastKey || _accDirty;
+
+    uint8_t n = 0;
+    out[n++] = (uint8_t)(TB_CMDC_TAG |
+                         (stamp ? TB_CMDC_F_TS : 0) |
+                         (_lastWithAcc ? TB_CMDC_F_ACC : 0) |
+                         (cmd.arm ? TB_CMDC_F_ARM : 0));
+    out[n++] = seq;
+    out[n++] = (uint8_t)cmd.throttlePct;
+    out[n++] = (uint8_t)cmd.rudderPct;
+    if (_lastWithAcc) {
+      memcpy(out + n, cmd.acc, TB_CMDC_ACC_LEN);
+      n += TB_CMDC_ACC_LEN;
+    }
+    if (stamp) {
+      TbStoreLe32(out + n, token);
+      n += TB_TS_LEN;
+    }
+
+    const uint16_t crc = TbCrc16Ccitt(out, n);
+    out[n++] = (uint8_t)(crc & 0xFF);
+    out[n++] = (uint8_t)(crc >> 8);
+    return n;
+  }
+
+  // Auto-ack result of the frame returned by the last encode()
+  void noteResult(bool acked) {
+    if (!acked) {
+      _keyDue = true;
+      return;
+    }
+    if (_lastWithAcc) _accDirty = false;
+    if (_lastKey) {
+      _keyDue = false;
+      _sinceKey = 0;
+    } else {
+      _sinceKey++;
+    }
+  }
+
+private:
+  static constexpr uint8_t KEY_EVERY = 10;
+
+  uint8_t _acc[TB_CMDC_ACC_LEN] = {0};
+  bool _accDirty = false;
+  bool _keyDue = true;
+  uint8_t _sinceKey = 0;
+  bool _lastKey = false;
+  bool _lastWithAcc = false;
+};
+
 // ============================================================================
 // KY-040 fixed state-table encoder (ownprox/buxtronix style)
 // NOTE: ISR intentionally NOT IRAM_ATTR (uses digitalRead; avoids linker issues)
@@ -344,6 +407,159 @@ private:
   float _value = 0.0f;
 };
 
+// ============================================================================
+// Event-driven send scheduler
+// ============================================================================
+// Sends as soon as the ramped command changes (capped at MIN_INTERVAL_MS), at
+// once on arm/disarm, and otherwise only a heartbeat. The RX graded failsafe
+// counts silence past HEARTBEAT_MS (+ loop slack) as a missed frame and every
+// further MIN_INTERVAL_MS as another: HOLD after two, NEUTRAL after four
+// (~185 ms). So a failed send, heartbeat or event, stays pending and is
+// retried at MIN_INTERVAL_MS, and the heartbeat must not slip.
+class TxSendScheduler {
+public:
+  static constexpr uint32_t MIN_INTERVAL_MS = TB_TX_MIN_INTERVAL_MS;
+  static constexpr uint32_t HEARTBEAT_MS    = TB_TX_HEARTBEAT_MS;   // RX Failsafe / MotionStage gap bound
+
+  void begin(uint32_t nowMs) {
+    _lastSendMs = nowMs;
+    _dirty = false;
+    _urgent = false;
+    _retry = false;
+    _winStartMs = nowMs;
+    _winEvent = _winHeartbeat = 0;
+    _winLatMaxUs = 0;
+    _eventPerSec = _heartbeatPerSec = 0;
+    _latAvgUs = _latMaxUs = _armLatUs = 0;
+  }
+
+  // Outgoing command differs from the last one delivered; urgent = arm changed
+  void noteChange(bool urgent, uint32_t nowUs) {
+    if (!_dirty) {
+      _dirty = true;
+      _dirtySinceUs = nowUs;
+    }
+    if (urgent) _urgent = true;
+  }
+
+  bool due(uint32_t nowMs) const {
+    const uint32_t since = nowMs - _lastSendMs;
+    if (_urgent) return true;
+    if ((_dirty || _retry) && since >= MIN_INTERVAL_MS) return true;
+    return since >= HEARTBEAT_MS;
+  }
+
+  void noteSent(bool ok, uint32_t nowMs, uint32_t nowUs) {
+    _lastSendMs = nowMs;
+
+    if (_dirty) {
+      _winEvent++;
+      if (ok) {
+        const uint32_t lat = nowUs - _dirtySinceUs;
+        _latAvgUs = (_latAvgUs == 0) ? lat : _latAvgUs + (((int32_t)lat - (int32_t)_latAvgUs) >> 3);
+        if (lat > _winLatMaxUs) _winLatMaxUs = lat;
+        if (_urgent) _armLatUs = lat;
+        _dirty = false;
+      }
+    } else {
+      _winHeartbeat++;
+    }
+    _retry = !ok;
+    _urgent = false;
+
+    const uint32_t elapsed = nowMs - _winStartMs;
+    if (elapsed >= 1000) {
+      _eventPerSec = (_winEvent * 1000UL) / elapsed;
+      _heartbeatPerSec = (_winHeartbeat * 1000UL) / elapsed;
+      _latMaxUs = _winLatMaxUs;
+      _winEvent = _winHeartbeat = 0;
+      _winLatMaxUs = 0;
+      _winStartMs = nowMs;
+    }
+  }
+
+  uint32_t sendsPerSec() const { return _eventPerSec + _heartbeatPerSec; }
+  uint32_t eventPerSec() const { return _eventPerSec; }
+  uint32_t heartbeatPerSec() const { return _heartbeatPerSec; }
+  uint32_t latencyAvgUs() const { return _latAvgUs; }
+  uint32_t latencyMaxUs() const { return _latMaxUs; }   // max over last 1 s window
+  uint32_t armLatencyUs() const { return _armLatUs; }   // last arm/disarm change
+
+private:
+  uint32_t _lastSendMs = 0;
+  bool _dirty = false;
+  bool _urgent = false;
+  bool _retry = false;   // last send failed; the RX may be short of a heartbeat
+  uint32_t _dirtySinceUs = 0;
+
+  uint32_t _winStartMs = 0;
+  uint32_t _winEvent = 0;
+  uint32_t _winHeartbeat = 0;
+  uint32_t _winLatMaxUs = 0;
+  uint32_t _eventPerSec = 0;
+  uint32_t _heartbeatPerSec = 0;
+  uint32_t _latAvgUs = 0;
+  uint32_t _latMaxUs = 0;
+  uint32_t _armLatUs = 0;
+};
+
+// ============================================================================
+// LOOP TIMING (tick() duration histogram)
+// ============================================================================
+// log2 buckets from 250 us: <0.25, <0.5, <1, <2, <4, <8, <16, >=16 ms. Counts
+// are kept whole (not decayed) so the rare long stalls stay visible; 'loop
+// reset' starts a new comparison. radio = longest single pass spent in radio
+// calls (service + CMD start): the blocking write shows up there with
+// TB_TX_ASYNC 0.
+class TxLoopStat {
+public:
+  static constexpr uint8_t BUCKETS = 8;
+
+  void reset(uint32_t nowMs) {
+    memset(_count, 0, sizeof(_count));
+    _maxUs = _winMaxUs = _lastWinMaxUs = 0;
+    _radioMaxUs = _winRadioMaxUs = _lastWinRadioMaxUs = 0;
+    _winStartMs = nowMs;
+  }
+
+  void add(uint32_t us, uint32_t radioUs, uint32_t nowMs) {
+    uint8_t b = 0;
+    uint32_t edge = 250;
+    while (b < BUCKETS - 1 && us >= edge) {
+      b++;
+      edge <<= 1;
+    }
+    _count[b]++;
+    if (us > _maxUs) _maxUs = us;
+    if (us > _winMaxUs) _winMaxUs = us;
+    if (radioUs > _radioMaxUs) _radioMaxUs = radioUs;
+    if (radioUs > _winRadioMaxUs) _winRadioMaxUs = radioUs;
+
+    if (nowMs - _winStartMs >= 1000) {
+      _lastWinMaxUs = _winMaxUs;
+      _lastWinRadioMaxUs = _winRadioMaxUs;
+      _winMaxUs = _winRadioMaxUs = 0;
+      _winStartMs = nowMs;
+    }
+  }
+
+  uint32_t count(uint8_t b) const { return _count[b]; }
+  uint32_t maxUs() const { return _maxUs; }                   // since reset
+  uint32_t windowMaxUs() const { return _lastWinMaxUs; }      // last 1 s window
+  uint32_t radioMaxUs() const { return _radioMaxUs; }
+  uint32_t windowRadioMaxUs() const { return _lastWinRadioMaxUs; }
+
+private:
+  uint32_t _count[BUCKETS] = {0};
+  uint32_t _maxUs = 0;
+  uint32_t _winMaxUs = 0;
+  uint32_t _lastWinMaxUs = 0;
+  uint32_t _radioMaxUs = 0;
+  uint32_t _winRadioMaxUs = 0;
+  uint32_t _lastWinRadioMaxUs = 0;
+  uint32_t _winStartMs = 0;
+};
+
 // ============================================================================
 // INPUTS => TbCmdV1 setpoints (CANON mapping)
 // ============================================================================
@@ -352,7 +568,7 @@ public:
   enum MenuPage : uint8_t {
     MENU_NONE = 0,
     MENU_ROOT,
-    MENU_SUBMENU_1,
+    MENU_DIAG,
     MENU_SUBMENU_2,
     MENU_SUBMENU_3
   };
@@ -434,7 +650,7 @@ public:
   const char* menuTitle() const {
     switch (_menuPage) {
       case MENU_ROOT: return "Main Menu";
-      case MENU_SUBMENU_1: return "Submenu 1";
+      case MENU_DIAG: return "Diagnostics";
       case MENU_SUBMENU_2: return "Submenu 2";
       case MENU_SUBMENU_3: return "Options";
       default: return "";
@@ -444,7 +660,6 @@ public:
   uint8_t menuItemCount() const {
     switch (_menuPage) {
       case MENU_ROOT: return 4;
-      case MENU_SUBMENU_1:
       case MENU_SUBMENU_2:
       case MENU_SUBMENU_3:
         return 4;
@@ -456,16 +671,10 @@ public:
   const char* menuItemLabel(uint8_t index) const {
     static const char* const rootItems[] = {
       "Exit",
-      "Submenu 1",
+      "Diagnostics",
       "Submenu 2",
       "Options"
     };
-    static const char* const submenu1Items[] = {
-      "Back",
-      "Placeholder A",
-      "Placeholder B",
-      "Placeholder C"
-    };
     static const char* const submenu2Items[] = {
       "Back",
       "Placeholder D",
@@ -482,7 +691,6 @@ public:
     const char* const* items = nullptr;
     switch (_menuPage) {
       case MENU_ROOT: items = rootItems; break;
-      case MENU_SUBMENU_1: items = submenu1Items; break;
       case MENU_SUBMENU_2: items = submenu2Items; break;
       case MENU_SUBMENU_3: items = submenu3Items; break;
       default: return "";
@@ -522,6 +730,13 @@ private:
   }
 
   void updateMenu(bool menuPressed) {
+    // Read-only stats page: turning does nothing, press goes back
+    if (_menuPage == MENU_DIAG) {
+      (void)_encMenu.readAndClear();
+      if (menuPressed) enterMenu(MENU_ROOT, 1);
+      return;
+    }
+
     const int dMenu = accel((int)_encMenu.readAndClear());
     if (dMenu != 0) {
       const int maxIndex = (int)menuItemCount() - 1;
@@ -536,7 +751,7 @@ private:
         case 0:
           _menuPage = MENU_NONE;
           return;
-        case 1: enterMenu(MENU_SUBMENU_1, 0); return;
+        case 1: enterMenu(MENU_DIAG, 0); return;
         case 2: enterMenu(MENU_SUBMENU_2, 0); return;
         case 3: enterMenu(MENU_SUBMENU_3, 0); return;
         default:
@@ -570,11 +785,610 @@ private:
   }
 };
 
+// ============================================================================
+// TELEMETRY MODEL (reassembled from ACKs)
+// ============================================================================
+// Paged ACKs refresh a subset of fields each time; every field keeps the
+// millis() of its last update so consumers can tell fresh from stale.
+struct TxTelemetry {
+  enum Field : uint8_t {
+    F_VSYS = 0, F_VPROP, F_ISYS,
+    F_RX_OK, F_RX_BAD,
+    F_T_MOTOR, F_T_ESC, F_WATER,
+    F_UPTIME, F_LOOP,
+    F_RX_LAT,
+    F_ENERGY,
+    F_SCHED,
+    F_SEQ,
+    F_COUNT
+  };
+
+  uint8_t  seqEcho = 0;
+  uint8_t  status = 0;
+  uint16_t vSys_mV = 0;
+  uint16_t vProp_mV = 0;
+  uint16_t iSys_mA = 0;
+  uint16_t rxOk = 0;
+  uint16_t rxBad = 0;
+  uint16_t rxCoalesced = 0;
+  uint8_t  fsEntries[3] = {0};
+  uint8_t  fsLastDepth = 0;
+  uint16_t fsLastOut_ms = 0;
+  uint8_t  rxCadence_ms = 0;
+  int16_t  tMotor_cC = 0;
+  int16_t  tEsc_cC = 0;
+  uint16_t waterRaw = 0;
+  uint16_t waterTrip_ms = 0;
+  uint32_t uptime_s = 0;
+  uint16_t loopAvg_us = 0;
+  uint16_t loopMax_us = 0;
+  uint16_t telMax_us = 0;
+  uint16_t adcRate_Hz = 0;
+  int16_t  acsDrift_mA = 0;
+  uint16_t freeSram_B = 0;
+  uint16_t rxLatAvg_us = 0;
+  uint16_t rxLatMax_us = 0;
+  uint8_t  rxLatHist[8] = {0};
+  uint8_t  rxMode = 0;
+  uint8_t  rxIrqMissed = 0;
+  uint16_t used_mAh = 0;
+  uint16_t used_cWh = 0;
+  uint16_t peak_mA = 0;
+  uint16_t avg_mA = 0;
+  uint16_t runtime_min = 0xFFFF;
+  uint16_t taskWcet_us[TB_SCHED_TASKS] = {0};
+  uint8_t  taskOverruns[TB_SCHED_TASKS] = {0};
+  uint16_t rxExtSeq = 0;
+  uint16_t seqLost = 0;
+  uint16_t seqDups = 0;
+  uint16_t seqReorders = 0;
+  uint8_t  seqLossHist[8] = {0};
+  uint8_t  seqLastWinLost = 0;
+
+  void reset() { *this = TxTelemetry(); }
+
+  bool waterAlarm() const { return (status & TB_S_F_WATER) != 0; }
+  bool waterSeen() const { return (status & TB_S_F_WATER_SEEN) != 0; }
+  uint8_t fsStage() const { return (uint8_t)((status & TB_S_FS_MASK) >> TB_S_FS_SHIFT); }
+
+  bool has(Field f) const { return (_seen & (1UL << f)) != 0; }
+  uint32_t ageMs(Field f, uint32_t nowMs) const { return has(f) ? nowMs - _updatedMs[f] : UINT32_MAX; }
+
+  // Legacy fixed ACK: every field at once
+  void apply(const TbAckView& v, uint32_t nowMs) {
+    seqEcho = v.seqEcho();
+    status  = v.status();
+    vSys_mV = v.vSys_mV();    touch(F_VSYS, nowMs);
+    vProp_mV = v.vProp_mV();  touch(F_VPROP, nowMs);
+    iSys_mA = v.iSys_mA();    touch(F_ISYS, nowMs);
+    rxOk  = v.rxOk();         touch(F_RX_OK, nowMs);
+    rxBad = v.rxBad();        touch(F_RX_BAD, nowMs);
+    tMotor_cC = v.tMotor_cC(); touch(F_T_MOTOR, nowMs);
+    tEsc_cC = v.tEsc_cC();    touch(F_T_ESC, nowMs);
+    waterRaw = v.waterRaw();  touch(F_WATER, nowMs);
+  }
+
+  // Paged ACK: fast block + one page
+  void apply(const TbAckPagedView& v, uint32_t nowMs) {
+    seqEcho = v.seqEcho();
+    status  = v.status();
+    vSys_mV = v.vSys_mV();    touch(F_VSYS, nowMs);
+    vProp_mV = v.vProp_mV();  touch(F_VPROP, nowMs);
+    iSys_mA = v.iSys_mA();    touch(F_ISYS, nowMs);
+
+    const uint8_t* b = v.body();
+    switch (v.page()) {
+      case TB_PAGE_LINK:
+        rxOk  = TbLoadLe16(b + offsetof(TbAckPageLink, rxOk));   touch(F_RX_OK, nowMs);
+        rxBad = TbLoadLe16(b + offsetof(TbAckPageLink, rxBad));  touch(F_RX_BAD, nowMs);
+        rxCoalesced = TbLoadLe16(b + offsetof(TbAckPageLink, coalesced));
+        memcpy(fsEntries, b + offsetof(TbAckPageLink, fsEntries), sizeof(fsEntries));
+        fsLastDepth  = b[offsetof(TbAckPageLink, fsLastDepth)];
+        fsLastOut_ms = TbLoadLe16(b + offsetof(TbAckPageLink, fsLastOut_ms));
+        rxCadence_ms = b[offsetof(TbAckPageLink, cadence_ms)];
+        break;
+      case TB_PAGE_THERMAL:
+        tMotor_cC = (int16_t)TbLoadLe16(b + offsetof(TbAckPageThermal, tMotor_cC)); touch(F_T_MOTOR, nowMs);
+        tEsc_cC   = (int16_t)TbLoadLe16(b + offsetof(TbAckPageThermal, tEsc_cC));   touch(F_T_ESC, nowMs);
+        waterRaw  = TbLoadLe16(b + offsetof(TbAckPageThermal, waterRaw));           touch(F_WATER, nowMs);
+        waterTrip_ms = TbLoadLe16(b + offsetof(TbAckPageThermal, waterTrip_ms));
+        break;
+      case TB_PAGE_SYSTEM:
+        uptime_s   = TbLoadLe32(b + offsetof(TbAckPageSystem, uptime_s));
+        loopAvg_us = TbLoadLe16(b + offsetof(TbAckPageSystem, loopAvg_us));
+        loopMax_us = TbLoadLe16(b + offsetof(TbAckPageSystem, loopMax_us));
+        telMax_us  = TbLoadLe16(b + offsetof(TbAckPageSystem, telMax_us));
+        adcRate_Hz = TbLoadLe16(b + offsetof(TbAckPageSystem, adcRate_Hz));
+        acsDrift_mA = (int16_t)TbLoadLe16(b + offsetof(TbAckPageSystem, acsDrift_mA));
+        freeSram_B = TbLoadLe16(b + offsetof(TbAckPageSystem, freeSram_B));
+        touch(F_UPTIME, nowMs);
+        touch(F_LOOP, nowMs);
+        break;
+      case TB_PAGE_RXLAT:
+        rxLatAvg_us = TbLoadLe16(b + offsetof(TbAckPageRxLat, avg_us));
+        rxLatMax_us = TbLoadLe16(b + offsetof(TbAckPageRxLat, max_us));
+        memcpy(rxLatHist, b + offsetof(TbAckPageRxLat, hist), sizeof(rxLatHist));
+        rxMode      = b[offsetof(TbAckPageRxLat, mode)];
+        rxIrqMissed = b[offsetof(TbAckPageRxLat, irqMissed)];
+        touch(F_RX_LAT, nowMs);
+        break;
+      case TB_PAGE_ENERGY:
+        used_mAh    = TbLoadLe16(b + offsetof(TbAckPageEnergy, used_mAh));
+        used_cWh    = TbLoadLe16(b + offsetof(TbAckPageEnergy, used_cWh));
+        peak_mA     = TbLoadLe16(b + offsetof(TbAckPageEnergy, peak_mA));
+        avg_mA      = TbLoadLe16(b + offsetof(TbAckPageEnergy, avg_mA));
+        runtime_min = TbLoadLe16(b + offsetof(TbAckPageEnergy, runtime_min));
+        touch(F_ENERGY, nowMs);
+        break;
+      case TB_PAGE_SCHED:
+        for (uint8_t i = 0; i < TB_SCHED_TASKS; i++) {
+          taskWcet_us[i] = TbLoadLe16(b + offsetof(TbAckPageSched, wcet_us) + 2 * i);
+        }
+        memcpy(taskOverruns, b + offsetof(TbAckPageSched, overruns), sizeof(taskOverruns));
+        touch(F_SCHED, nowMs);
+        break;
+      case TB_PAGE_SEQ:
+        rxExtSeq    = TbLoadLe16(b + offsetof(TbAckPageSeq, extSeq));
+        seqLost     = TbLoadLe16(b + offsetof(TbAckPageSeq, lost));
+        seqDups     = TbLoadLe16(b + offsetof(TbAckPageSeq, dups));
+        seqReorders = TbLoadLe16(b + offsetof(TbAckPageSeq, reorders));
+        memcpy(seqLossHist, b + offsetof(TbAckPageSeq, lossHist), sizeof(seqLossHist));
+        seqLastWinLost = b[offsetof(TbAckPageSeq, lastWinLost)];
+        touch(F_SEQ, nowMs);
+        break;
+      default:
+        break;
+    }
+  }
+
+private:
+  uint32_t _updatedMs[F_COUNT] = {0};
+  uint32_t _seen = 0;
+
+  void touch(Field f, uint32_t nowMs) {
+    _updatedMs[f] = nowMs;
+    _seen |= (1UL << f);
+  }
+};
+
+#if TB_HOP_SIM
+// Boot-time hop simulation: TbHopLeader against TbHopFollower over a synthetic
+// band, no radio involved. One attempt per SIM_STEP_MS; a frame is lost when
+// an interferer covering its channel is keyed, or on the background loss. The
+// ACK shares the frame's fate except for SIM_ACK_LOSS_PCT.
+struct TbHopSimJammer {
+  uint8_t lo;
+  uint8_t hi;
+  uint8_t dutyPct;
+  uint16_t roamMs;   // 0 = fixed, else re-centred at random every roamMs
+};
+
+struct TbHopSimScenario {
+  const char* name;
+  TbHopSimJammer jam[3];
+  uint8_t count;
+};
+
+static const TbHopSimScenario kTbHopSimScenarios[] = {
+  { "quiet",      { { 0, 0, 0, 0 } },                                       0 },
+  { "jam@fixed",  { { RF_CHANNEL - 1, RF_CHANNEL + 1, 90, 0 } },            1 },
+  { "wifi 1/6/11",{ { 1, 23, 40, 0 }, { 26, 48, 40, 0 }, { 51, 73, 40, 0 } }, 3 },
+  { "wifi6 busy", { { 26, 48, 85, 0 } },                                    1 },
+  { "roaming",    { { 0, 6, 95, 2000 }, { 0, 22, 60, 5000 } },              2 },
+};
+
+class TbHopSim {
+public:
+  enum Mode : uint8_t { FIXED, HOP, HOP_BL };
+
+  struct Result {
+    uint16_t deliveredPermille;
+    uint32_t worstGapMs;
+    uint16_t relocks;
+  };
+
+  Result run(const TbHopSimScenario& sc, Mode mode) {
+    _rng = 0x2545F491UL;
+    for (uint8_t i = 0; i < sc.count; i++) {
+      _jam[i] = sc.jam[i];
+      _jamNextMs[i] = 0;
+    }
+
+    TbHopLeader tx;
+    TbHopFollower rx;
+    tx.begin(0);
+    rx.begin(0);
+
+    uint32_t delivered = 0;
+    uint32_t attempts = 0;
+    uint32_t lastDeliveredMs = 0;
+    bool synced = false;
+    uint8_t seq = 1;
+    Result r {0, 0, 0};
+
+    for (uint32_t t = SIM_STEP_MS; t <= SIM_MS; t += SIM_STEP_MS, seq++) {
+      roam(sc, t);
+      rx.tick(t);
+
+      uint8_t txCh = RF_CHANNEL;
+      uint16_t mask = 0;
+      bool cfg = false;
+      if (mode != FIXED) {
+        if (mode == HOP_BL && tx.wantMask(t, mask)) {
+          tx.stageMask(mask);
+          cfg = true;
+        }
+        txCh = tx.pick(seq, t);
+      }
+
+      const uint8_t rxCh = (mode == FIXED) ? RF_CHANNEL : rx.channel();
+      const bool got = (txCh == rxCh) && !lost(sc, txCh);
+      const bool acked = got && (rnd() % 100) >= SIM_ACK_LOSS_PCT;
+
+      if (got) {
+        delivered++;
+        const uint32_t gap = t - lastDeliveredMs;
+        if (gap > r.worstGapMs) r.worstGapMs = gap;
+        lastDeliveredMs = t;
+        if (mode != FIXED) {
+          if (!rx.locked() && synced) r.relocks++;
+          synced = true;
+          if (cfg) rx.setMask(mask);
+          rx.noteRx(seq, true, t);
+        }
+      }
+      if (mode != FIXED) tx.noteResult(seq, acked, t);
+      attempts++;
+    }
+    if (SIM_MS - lastDeliveredMs > r.worstGapMs) r.worstGapMs = SIM_MS - lastDeliveredMs;
+    r.deliveredPermille = (uint16_t)((delivered * 1000UL) / attempts);
+    return r;
+  }
+
+private:
+  static constexpr uint32_t SIM_MS           = 120000;
+  static constexpr uint32_t SIM_STEP_MS      = 20;
+  static constexpr uint8_t  SIM_BG_LOSS_PCT  = 2;
+  static constexpr uint8_t  SIM_ACK_LOSS_PCT = 2;
+
+  uint32_t _rng = 1;
+  TbHopSimJammer _jam[3] = {};
+  uint32_t _jamNextMs[3] = {0};
+
+  uint32_t rnd() {
+    _rng ^= _rng << 13;
+    _rng ^= _rng >> 17;
+    _rng ^= _rng << 5;
+    return _rng;
+  }
+
+  void roam(const TbHopSimScenario& sc, uint32_t t) {
+    for (uint8_t i = 0; i < sc.count; i++) {
+      if (sc.jam[i].roamMs == 0 || t < _jamNextMs[i]) continue;
+      const uint8_t width = (uint8_t)(sc.jam[i].hi - sc.jam[i].lo);
+      _jam[i].lo = (uint8_t)(rnd() % (126 - width));
+      _jam[i].hi = (uint8_t)(_jam[i].lo + width);
+      _jamNextMs[i] = t + sc.jam[i].roamMs;
+    }
+  }
+
+  bool lost(const TbHopSimScenario& sc, uint8_t ch) {
+    for (uint8_t i = 0; i < sc.count; i++) {
+      if (ch >= _jam[i].lo && ch <= _jam[i].hi && (rnd() % 100) < _jam[i].dutyPct) return true;
+    }
+    return (rnd() % 100) < SIM_BG_LOSS_PCT;
+  }
+};
+
+static void TbHopSimulate() {
+  static const char* const modes[] = { "fixed", "hop", "hop+bl" };
+  TbHopSim sim;
+  logBoth("Hop sim: delivered % / worst gap ms / relocks");
+  for (uint8_t i = 0; i < sizeof(kTbHopSimScenarios) / sizeof(kTbHopSimScenarios[0]); i++) {
+    for (uint8_t m = TbHopSim::FIXED; m <= TbHopSim::HOP_BL; m++) {
+      const TbHopSim::Result r = sim.run(kTbHopSimScenarios[i], (TbHopSim::Mode)m);
+      logBothf("  %-11s %-6s %3u.%u%% %6lu %3u",
+               kTbHopSimScenarios[i].name, modes[m],
+               (unsigned int)(r.deliveredPermille / 10), (unsigned int)(r.deliveredPermille % 10),
+               (unsigned long)r.worstGapMs, (unsigned int)r.relocks);
+    }
+  }
+}
+#endif
+
+// ============================================================================
+// FLIGHT RECORDER PULL (RX log over TB_REC_REQ / TB_PAGE_REC)
+// ============================================================================
+// One TB_REC_REQ per REQ_GAP_MS alongside normal traffic; the RX freezes its
+// log on the first read and answers each request on its next ACK. A chunk is
+// kept only if it continues the copy, so lost or repeated ACKs cost a retry.
+class TxRecPull {
+public:
+  static constexpr uint16_t MAX_BYTES = 4096;   // > RX TB_REC_BYTES
+
+  void start(uint32_t nowMs) {
+    _active = true;
+    _timedOut = false;
+    _offset = 0;
+    _total = 0;
+    _reason = 0;
+    _lastReqMs = 0;
+    _lastProgressMs = nowMs;
+  }
+
+  // Due request offset, if any
+  bool wantRequest(uint32_t nowMs, uint16_t& outOffset) {
+    if (!_active) return false;
+    if (nowMs - _lastProgressMs > STALL_MS) {
+      _active = false;
+      _timedOut = true;
+      return false;
+    }
+    if (nowMs - _lastReqMs < REQ_GAP_MS) return false;
+    _lastReqMs = nowMs;
+    outOffset = _offset;
+    return true;
+  }
+
+  void onChunk(const uint8_t* body, uint32_t nowMs) {
+    if (!_active) return;
+    const uint16_t offset = TbLoadLe16(body + offsetof(TbAckPageRec, offset));
+    const uint16_t total  = TbLoadLe16(body + offsetof(TbAckPageRec, total));
+    uint8_t len = body[offsetof(TbAckPageRec, len)];
+    if (offset != _offset || len > sizeof(TbAckPageRec::data)) return;
+
+    _total = total < MAX_BYTES ? total : MAX_BYTES;
+    _reason = body[offsetof(TbAckPageRec, reason)];
+    if (_offset + len > _total) len = (uint8_t)(_total - _offset);
+    memcpy(_buf + _offset, body + offsetof(TbAckPageRec, data), len);
+    _offset = (uint16_t)(_offset + len);
+    _lastProgressMs = nowMs;
+    if (_offset >= _total) _active = false;
+  }
+
+  bool active() const { return _active; }
+  bool timedOut() const { return _timedOut; }
+  uint16_t received() const { return _offset; }
+  uint16_t total() const { return _total; }
+  uint8_t reason() const { return _reason; }
+
+  // Byte source for TbRecDecoder over the completed copy
+  struct Source {
+    explicit Source(const TxRecPull& p) : pull(p) {}
+    const TxRecPull& pull;
+    uint16_t pos = 0;
+    bool get(uint8_t& b) {
+      if (pos >= pull._offset) return false;
+      b = pull._buf[pos++];
+      return true;
+    }
+  };
+
+private:
+  static constexpr uint32_t REQ_GAP_MS = 20;
+  static constexpr uint32_t STALL_MS   = 3000;
+
+  uint8_t  _buf[MAX_BYTES];
+  bool     _active = false;
+  bool     _timedOut = false;
+  uint16_t _offset = 0;
+  uint16_t _total = 0;
+  uint8_t  _reason = 0;
+  uint32_t _lastReqMs = 0;
+  uint32_t _lastProgressMs = 0;
+};
+
+// ============================================================================
+// RTT / ONE-WAY DELAY / JITTER (stamped CMD frames, TB_PAGE_TIME echo)
+// ============================================================================
+// The first CMD at least TB_RTT_PERIOD_MS after the last stamped one carries its
+// micros() token, so the sample rate holds at ~5 Hz whether the scheduler is
+// sending heartbeats (10 Hz) or a moving stick (up to 50 Hz). Per stamped frame:
+//   rtt     token -> completion with the auto-ACK (retransmits included; with
+//           TB_TX_ASYNC plus the gap to the STATUS poll that saw it, which
+//           the App keeps short by polling around the OLED / WiFi work; a
+//           frame whose completion was seen more than TB_RTT_MAX_POLL_GAP_US
+//           after the previous poll is counted as late, not timed)
+//   one-way rtt - ACK return (turnaround + ACK airtime at the current rate)
+//           + the RX's arrival -> Actuators::apply time echoed with the token,
+//           i.e. command leaves the TX -> actuators hold it
+//   jitter  RFC 3550 style smoothed |one-way difference| between echoes
+// The RX echoes after applying, so the token comes back one or two frames
+// later; the last RING stamped frames are kept to pair it.
+static constexpr uint32_t TB_RTT_PERIOD_MS  = 200;     // ~5 Hz at any send rate
+static constexpr uint32_t TB_RTT_MIN_WIN_MS = 10000;   // min covers the last 1-2 windows
+static constexpr uint16_t NRF_TURNAROUND_US = 130;     // PRX TX settling before the ACK
+static constexpr uint32_t TB_RTT_MAX_POLL_GAP_US = 2000;   // completion timestamp error bound
+
+// Streaming quantile (stochastic approximation): each sample moves the
+// estimate up by step * q or down by step * (1 - q), so it settles where a
+// fraction q of samples fall below. The step tracks the spread (mean |x - est|
+// / 4), so no sample buffer and no fixed scale.
+class TbQuantile {
+public:
+  explicit TbQuantile(float q) : _q(q) {}
+
+  void reset() { _n = 0; }
+
+  void add(float x) {
+    if (_n++ == 0) {
+      _est = x;
+      _dev = 0;
+      return;
+    }
+    _dev += (fabsf(x - _est) - _dev) / 32.0f;
+    const float step = fmaxf(_dev * 0.25f, 1.0f);
+    if (x > _est) _est += step * _q;
+    else _est -= step * (1.0f - _q);
+  }
+
+  float value() const { return _n ? _est : 0.0f; }
+
+private:
+  float    _q;
+  float    _est = 0;
+  float    _dev = 0;
+  uint32_t _n = 0;
+};
+
+class TxDelayStat {
+public:
+  void reset() {
+    _n = 0;
+    _avg = 0;
+    _p99.reset();
+    _winMin = _prevMin = UINT32_MAX;
+    _winStartMs = millis();
+  }
+
+  void add(uint32_t us, uint32_t nowMs) {
+    _avg = (_n == 0) ? (float)us : _avg + ((float)us - _avg) / 16.0f;
+    _p99.add((float)us);
+    if (nowMs - _winStartMs >= TB_RTT_MIN_WIN_MS) {
+      _prevMin = _winMin;
+      _winMin = UINT32_MAX;
+      _winStartMs = nowMs;
+    }
+    if (us < _winMin) _winMin = us;
+    _n++;
+  }
+
+  uint32_t count() const { return _n; }
+  uint32_t minUs() const { return _n ? min(_winMin, _prevMin) : 0; }
+  uint32_t avgUs() const { return (uint32_t)lroundf(_avg); }
+  uint32_t p99Us() const { return (uint32_t)lroundf(_p99.value()); }
+
+private:
+  uint32_t   _n = 0;
+  float      _avg = 0;
+  TbQuantile _p99 { 0.99f };
+  uint32_t   _winMin = UINT32_MAX;
+  uint32_t   _prevMin = UINT32_MAX;
+  uint32_t   _winStartMs = 0;
+};
+
+class TxRttMeter {
+public:
+  void reset() {
+    _rtt.reset();
+    _oneWay.reset();
+    _jitter = 0;
+    _haveLast = false;
+    _stamped = false;
+    _unpaired = 0;
+    _late = 0;
+    memset(_ring, 0, sizeof(_ring));
+    _head = 0;
+  }
+
+  // Whether the next CMD carries a token
+  bool stampDue(uint32_t nowMs) {
+    if (_stamped && nowMs - _lastStampMs < TB_RTT_PERIOD_MS) return false;
+    _stamped = true;
+    _lastStampMs = nowMs;
+    return true;
+  }
+
+  // Stamped frame auto-acked; ackReturnUs = turnaround + ACK airtime
+  void noteAcked(uint32_t token, uint32_t rttUs, uint16_t ackReturnUs, uint32_t nowMs) {
+    _rtt.add(rttUs, nowMs);
+    push(token, rttUs > ackReturnUs ? rttUs - ackReturnUs : 0, true);
+  }
+
+  // Stamped frame auto-acked, but its completion was seen too late to time;
+  // kept so the echo pairs (and is dropped) instead of counting as unpaired
+  void noteLate(uint32_t token) {
+    push(token, 0, false);
+    if (_late < UINT16_MAX) _late++;
+  }
+
+  void onEcho(uint32_t token, uint16_t applyUs, uint32_t nowMs) {
+    for (uint8_t i = 0; i < RING; i++) {
+      Entry& e = _ring[i];
+      if (e.used || e.token != token) continue;
+      e.used = true;
+      if (!e.timed) return;
+      const uint32_t owd = e.airUs + applyUs;
+      _oneWay.add(owd, nowMs);
+      if (_haveLast) {
+        const float d = fabsf((float)owd - (float)_lastOwd);
+        _jitter += (d - _jitter) / 16.0f;
+      }
+      _lastOwd = owd;
+      _haveLast = true;
+      return;
+    }
+    if (_unpaired < UINT16_MAX) _unpaired++;   // repeated ACK, or stamped frame not acked
+  }
+
+  const TxDelayStat& rtt() const { return _rtt; }
+  const TxDelayStat& oneWay() const { return _oneWay; }
+  uint32_t jitterUs() const { return (uint32_t)lroundf(_jitter); }
+  uint16_t unpaired() const { return _unpaired; }
+  uint16_t late() const { return _late; }
+
+private:
+  static constexpr uint8_t RING = 4;
+  struct Entry {
+    uint32_t token;
+    uint32_t airUs;   // rtt minus the ACK return leg
+    bool     used;
+    bool     timed;   // false: completion seen late, echo is dropped
+  };
+
+  void push(uint32_t token, uint32_t airUs, bool timed) {
+    Entry& e = _ring[_head];
+    e.token = token;
+    e.airUs = airUs;
+    e.used = false;
+    e.timed = timed;
+    _head = (uint8_t)((_head + 1) % RING);
+  }
+
+  TxDelayStat _rtt;
+  TxDelayStat _oneWay;
+  float       _jitter = 0;
+  uint32_t    _lastOwd = 0;
+  bool        _haveLast = false;
+  bool        _stamped = false;
+  uint32_t    _lastStampMs = 0;
+  uint16_t    _unpaired = 0;
+  uint16_t    _late = 0;
+  Entry       _ring[RING] = {};
+  uint8_t     _head = 0;
+};
+
 // ============================================================================
 // RADIO LINK (send + ack telemetry parse)
 // ============================================================================
+// One frame in flight at a time. With TB_TX_ASYNC the frame is started with
+// startWrite() and poll() reads STATUS (TX_DS / MAX_RT) from service() and
+// around every blocking stretch of tick() (OLED refresh, WiFi console), so a
+// marginal link costs retransmit time on the air, not in tick(). The
+// result (plus any ACK payload, harvested on completion) is handed to the App
+// through takeDone(); no new frame starts until it has been taken. Control
+// frames (TB_LINK_CFG, TB_HOP_CFG, TB_REC_REQ) are queued and started by
+// service() whenever the link is idle. TB_TX_ASYNC 0 runs the same path with
+// the blocking radio.write(), completing inside the start call.
+static constexpr uint32_t TB_TX_TIMEOUT_US = 40000;   // > 16 attempts x (ARD 1500 us + airtime), RF24 default retries
+
 class TxRadioLink {
 public:
+  enum TxKind : uint8_t {
+    TX_NONE = 0,
+    TX_CMD,
+    TX_LINK_CFG,
+    TX_HOP_CFG,
+    TX_REC_REQ
+  };
+
+  struct Done {
+    TxKind  kind;
+    bool    ok;           // auto-acked
+    bool    ackUpdated;   // good ACK payload parsed
+    uint8_t arg;          // TX_LINK_CFG: level, TX_REC_REQ: TbRecOp
+  };
+
   bool begin() {
     SPI.begin(PIN_SPI_SCK, PIN_SPI_MISO, PIN_SPI_MOSI);
 
@@ -583,9 +1397,12 @@ public:
       return false;
     }
 
+#if TB_HOP
+    _hop.begin(millis());   // channel is set per attempt in transmit()
+#else
     radio.setChannel(RF_CHANNEL);
-    radio.setPALevel(RF24_PA_MIN);
-    radio.setDataRate(RF24_250KBPS);
+#endif
+    applyLevel(TB_LINK_BOOT_LEVEL);
     radio.setAutoAck(true);
 
     radio.enableDynamicPayloads();
@@ -593,66 +1410,528 @@ public:
 
     radio.openWritingPipe(PIPE_ADDR);
     radio.stopListening();
+    radio.flush_tx();
+    bool txOk = false, txFail = false, rxReady = false;
+    radio.whatHappened(txOk, txFail, rxReady);   // clear stale STATUS flags
 
     _seq = 1;
+    _inFlight = false;
+    _donePending = false;
+    _linkCfgWanted = false;
+    _recResumeWanted = false;
+    _timeouts = 0;
+    _cmdc.reset();
+    _airBytes = 0;
+    _airBytesPerSec = 0;
+    _airWindowStartMs = millis();
     _lastSendOk = false;
     _lastAckUpdated = false;
     _lastAckMs = millis();
-    memset(&_lastAck, 0, sizeof(_lastAck));
+    _tel.reset();
+    _rtt.reset();
+    return true;
+  }
+
+  // In flight, or completed and not yet taken
+  bool busy() const { return _inFlight || _donePending; }
+
+  bool takeDone(Done& out) {
+    if (!_donePending) return false;
+    out = _done;
+    _donePending = false;
     return true;
   }
 
-  bool sendCmd(const TbCmdV1& cmd) {
+  // Completes the frame in flight (STATUS poll, never waits). Cheap; the App
+  // calls it before and after anything that blocks, so the completion
+  // timestamp is not pushed back by a display refresh
+  void poll() {
+#if TB_TX_ASYNC
+    if (!_inFlight) return;
+    bool txOk = false, txFail = false, rxReady = false;
+    radio.whatHappened(txOk, txFail, rxReady);
+    if (txOk || txFail) {
+      if (txFail) radio.flush_tx();   // MAX_RT leaves the payload in the TX FIFO
+      complete(txOk);
+    } else if (micros() - _txStartUs >= TB_TX_TIMEOUT_US) {
+      radio.flush_tx();               // lost STATUS edge / radio glitch
+      if (_timeouts < UINT16_MAX) _timeouts++;
+      complete(false);
+    } else {
+      _pollUs = micros();
+    }
+#endif
+  }
+
+  // poll(), then starts a queued control frame when the link is idle
+  void service(uint32_t nowMs) {
+    poll();
+    if (busy()) return;
+
+    if (_linkCfgWanted) {
+      _linkCfgWanted = false;
+      TbLinkCfgV1 cfg {};
+      cfg.level = _linkCfgLevel;
+      startControl(TX_LINK_CFG, TB_LINK_CFG, _linkCfgLevel, (const uint8_t*)&cfg, sizeof(cfg));
+      return;
+    }
+    if (_recResumeWanted) {
+      _recResumeWanted = false;
+      startRecReq(TB_REC_OP_RESUME, 0);
+      return;
+    }
+    maintainHop(nowMs);
+    if (!busy()) maintainRec(nowMs);
+  }
+
+  // Starts a CMD frame; false when the link is busy or the frame cannot be built
+  bool startCmd(const TbCmdV1& cmd) {
+    if (busy()) return false;
+
     uint8_t frame[TB_MAX_AIR] = {0};
     uint8_t frameLen = 0;
 
-    if (!TbBuildFrame(TB_CMD, 0, _seq++, (const uint8_t*)&cmd, sizeof(cmd), frame, frameLen)) {
+#if TB_RTT
+    const bool stamp = _rtt.stampDue(millis());
+#else
+    const bool stamp = false;
+#endif
+    const uint32_t token = micros();
+    const uint8_t seq = (uint8_t)_seq++;
+
+#if TB_CMD_COMPACT
+    frameLen = _cmdc.encode(cmd, seq, frame, stamp, token);
+#else
+    uint8_t pay[TB_CMD_LEN + TB_TS_LEN];
+    memcpy(pay, &cmd, TB_CMD_LEN);
+    TbStoreLe32(pay + TB_CMD_LEN, token);
+    if (!TbBuildFrame(TB_CMD, stamp ? TB_HF_TS : 0, seq, pay,
+                      (uint8_t)(TB_CMD_LEN + (stamp ? TB_TS_LEN : 0)), frame, frameLen)) {
       _lastSendOk = false;
       return false;
     }
+#endif
 
-    _lastSendOk = radio.write(frame, frameLen);
-    _lastAckUpdated = false;
+    _cmdStamp = stamp;
+    _cmdToken = token;
+    transmit(TX_CMD, 0, seq, frame, frameLen);
+    return true;
+  }
 
-    if (_lastSendOk) {
-      TbAckV2 ack {};
-      if (readAck(ack)) {
-        _lastAck = ack;
-        _lastAckMs = millis();
-        _lastAckUpdated = true;
-      }
-    }
-    return _lastSendOk;
+  // Link adaptation handshake: sent when the link is next idle; the Done for
+  // TX_LINK_CFG says whether the RX has it (it switches on receipt), and the
+  // caller then switches this end with applyLevel().
+  void requestLinkCfg(uint8_t level) {
+    _linkCfgLevel = level;
+    _linkCfgWanted = true;
+  }
+
+  // Only between frames (not while one is in flight)
+  void applyLevel(uint8_t level) {
+    radio.setDataRate(kTbLinkLevels[level].rate);
+    radio.setPALevel(kTbLinkLevels[level].pa);
+    _level = level;
   }
 
+#if TB_HOP
+  const TbHopLeader& hop() const { return _hop; }
+#endif
+
+  void startRecPull() { _recPull.start(millis()); }
+  // Done for TX_REC_REQ / TB_REC_OP_RESUME says whether the RX got it
+  void requestRecResume() { _recResumeWanted = true; }
+  const TxRecPull& recPull() const { return _recPull; }
+
+  uint8_t level() const { return _level; }
+  uint8_t lastArc() const { return _lastArc; }
+
   bool lastSendOk() const { return _lastSendOk; }
   bool lastAckUpdated() const { return _lastAckUpdated; }
-  const TbAckV2& lastAck() const { return _lastAck; }
+  const TxTelemetry& telemetry() const { return _tel; }
+  const TxRttMeter& rtt() const { return _rtt; }
+  uint16_t txSeq() const { return _seq; }
+  uint16_t txTimeouts() const { return _timeouts; }
   uint32_t lastAckMs() const { return _lastAckMs; }
 
+  // First ACK carrying TB_S_F_WATER: when it was parsed, and an upper bound on
+  // its time in flight (the RX re-queues on the crossing, so the bit rides the
+  // first frame sent after the previous good ACK)
+  bool takeWaterAlarm(uint32_t& outAckUs, uint32_t& outLinkUs) {
+    if (!_waterEdge) return false;
+    _waterEdge = false;
+    outAckUs = _waterAckUs;
+    outLinkUs = _waterAckUs - _waterPrevAckedTxUs;
+    return true;
+  }
+  uint32_t airBytesPerSec() const { return _airBytesPerSec; }
+
 private:
-  uint8_t _seq = 1;
+  uint16_t _seq = 1;   // extended; the low byte goes on the air (the RX unwraps it)
+  uint8_t _level = TB_LINK_BOOT_LEVEL;
+  uint8_t _lastArc = 0;
   bool _lastSendOk = false;
   bool _lastAckUpdated = false;
   uint32_t _lastAckMs = 0;
-  TbAckV2 _lastAck{};
+  uint32_t _txStartUs = 0;
+  uint32_t _txDoneUs = 0;         // completion seen (TX_DS / MAX_RT / timeout)
+  uint32_t _pollUs = 0;           // last STATUS poll that found the frame still in flight
+  uint8_t  _lastAckLen = 0;       // ACK payload bytes of the last send (0 = empty ACK)
+  bool     _inFlight = false;
+  TxKind   _txKind = TX_NONE;
+  uint8_t  _txArg = 0;
+  uint8_t  _txLen = 0;
+  uint8_t  _txSeq = 0;
+  bool     _donePending = false;
+  Done     _done {};
+  bool     _cmdStamp = false;     // CMD in flight carries _cmdToken
+  uint32_t _cmdToken = 0;
+  bool     _linkCfgWanted = false;
+  uint8_t  _linkCfgLevel = 0;
+  bool     _recResumeWanted = false;
+  uint16_t _timeouts = 0;
+  uint32_t _ackedTxStartUs = 0;   // start of the last frame that returned a good ACK
+  bool     _waterAlarm = false;
+  bool     _waterEdge = false;
+  uint32_t _waterAckUs = 0;
+  uint32_t _waterPrevAckedTxUs = 0;
+  TxTelemetry _tel{};
+  TxRttMeter _rtt;
+  TbCmdCompactEncoder _cmdc;
+#if TB_HOP
+  TbHopLeader _hop;
+#endif
+  TxRecPull _recPull;
+
+  // Adaptive hop blacklist: at most one TB_HOP_CFG per TbHopLeader eval period
+  void maintainHop(uint32_t nowMs) {
+#if TB_HOP
+    uint16_t mask = 0;
+    if (!_hop.wantMask(nowMs, mask)) return;
+
+    TbHopCfgV1 cfg {};
+    cfg.blacklist = mask;
+    _hop.stageMask(mask);
+    startControl(TX_HOP_CFG, TB_HOP_CFG, 0, (const uint8_t*)&cfg, sizeof(cfg));
+#else
+    (void)nowMs;
+#endif
+  }
+
+  // Flight recorder pull: one TB_REC_REQ read per idle slot while a pull is running
+  void maintainRec(uint32_t nowMs) {
+    uint16_t offset = 0;
+    if (!_recPull.wantRequest(nowMs, offset)) return;
+    startRecReq(TB_REC_OP_READ, offset);
+  }
+
+  void startRecReq(uint8_t op, uint16_t offset) {
+    TbRecReqV1 req {};
+    req.op = op;
+    req.offset = offset;
+    startControl(TX_REC_REQ, TB_REC_REQ, op, (const uint8_t*)&req, sizeof(req));
+  }
+
+  void startControl(TxKind kind, uint8_t type, uint8_t arg, const uint8_t* pay, uint8_t payLen) {
+    uint8_t frame[TB_MAX_AIR] = {0};
+    uint8_t frameLen = 0;
+    const uint8_t seq = (uint8_t)_seq++;
+    if (!TbBuildFrame(type, 0, seq, pay, payLen, frame, frameLen)) return;
+    transmit(kind, arg, seq, frame, frameLen);
+  }
+
+  // Per packet on air: preamble 1 + address 5 + PCF 9 bits + CRC 2 (rounded to bytes)
+  static constexpr uint8_t NRF_AIR_OVERHEAD = 9;
+
+  // PRX turnaround + ACK packet airtime at the current link level
+  uint16_t ackReturnUs(uint8_t ackLen) const {
+    const rf24_datarate_e rate = kTbLinkLevels[_level].rate;
+    const uint32_t usPer8Bytes = rate == RF24_2MBPS ? 32 : rate == RF24_1MBPS ? 64 : 256;
+    return (uint16_t)(NRF_TURNAROUND_US + ((uint32_t)(ackLen + NRF_AIR_OVERHEAD) * usPer8Bytes) / 8);
+  }
+  uint32_t _airBytes = 0;
+  uint32_t _airBytesPerSec = 0;
+  uint32_t _airWindowStartMs = 0;
+
+  // seq: the frame's on-air seq, which picks its hop slot
+  void transmit(TxKind kind, uint8_t arg, uint8_t seq, const uint8_t* frame, uint8_t frameLen) {
+#if TB_HOP
+    radio.setChannel(_hop.pick(seq, millis()));
+#endif
+    _txSeq = seq;
+    _txKind = kind;
+    _txArg = arg;
+    _txLen = frameLen;
+    _inFlight = true;
+    _txStartUs = micros();
+    _pollUs = _txStartUs;
+#if TB_TX_ASYNC
+    radio.startWrite(frame, frameLen, false);   // CE pulse; service() sees TX_DS / MAX_RT
+#else
+    complete(radio.write(frame, frameLen));
+#endif
+  }
+
+  // Frame in flight finished: link bookkeeping, ACK payload, per-kind result
+  void complete(bool ok) {
+    const uint32_t nowMs = millis();
+    _txDoneUs = micros();
+    _inFlight = false;
+    _lastAckLen = 0;
+#if TB_HOP
+    _hop.noteResult(_txSeq, ok, nowMs);
+#endif
+    _lastArc = radio.getARC();
+    noteAirBytes(_txLen, _lastArc);
+
+    bool ackUpdated = false;
+    if (ok && readAck(nowMs)) {
+      _lastAckMs = nowMs;
+      ackUpdated = true;
+      noteWaterFlag();
+      _ackedTxStartUs = _txStartUs;
+    }
+
+    if (_txKind == TX_CMD) {
+      _lastSendOk = ok;
+      _lastAckUpdated = ackUpdated;
+#if TB_RTT
+      if (_cmdStamp && ok) {
+        // TX_DS landed somewhere between the previous poll and this one
+        // (the blocking write returns on it, no gap)
+        if (!TB_TX_ASYNC || _txDoneUs - _pollUs <= TB_RTT_MAX_POLL_GAP_US) {
+          const uint32_t rttUs = _txDoneUs - _cmdToken;
+          _rtt.noteAcked(_cmdToken, rttUs, ackReturnUs(_lastAckLen), nowMs);
+        } else {
+          _rtt.noteLate(_cmdToken);
+        }
+      }
+#endif
+#if TB_CMD_COMPACT
+      _cmdc.noteResult(ok);
+#endif
+    }
 
-  bool readAck(TbAckV2& outAck) {
+    _done.kind = _txKind;
+    _done.ok = ok;
+    _done.ackUpdated = ackUpdated;
+    _done.arg = _txArg;
+    _donePending = true;
+  }
+
+  void noteWaterFlag() {
+    const bool wet = _tel.waterAlarm();
+    if (wet && !_waterAlarm) {
+      _waterEdge = true;
+      _waterAckUs = micros();
+      _waterPrevAckedTxUs = _ackedTxStartUs;
+    }
+    _waterAlarm = wet;
+  }
+
+  // Counts every transmission attempt, including auto-retransmits
+  void noteAirBytes(uint8_t payLen, uint8_t retransmits) {
+    _airBytes += (uint32_t)(1 + retransmits) * (payLen + NRF_AIR_OVERHEAD);
+
+    const uint32_t now = millis();
+    const uint32_t elapsed = now - _airWindowStartMs;
+    if (elapsed >= 1000) {
+      _airBytesPerSec = (_airBytes * 1000UL) / elapsed;
+      _airBytes = 0;
+      _airWindowStartMs = now;
+    }
+  }
+
+  // Validates in the radio buffer (fixed v2 or paged ACK); the telemetry
+  // model is only touched for a good ACK.
+  bool readAck(uint32_t nowMs) {
     if (!radio.isAckPayloadAvailable()) return false;
 
     const uint8_t len = radio.getDynamicPayloadSize();
-    if (len != sizeof(TbAckV2)) {
-      uint8_t junk[32] = {0};
-      radio.read(junk, min<uint8_t>(len, 32));
-      return false;
+    uint8_t buf[TB_MAX_AIR];
+    radio.read(buf, min<uint8_t>(len, TB_MAX_AIR));
+    _lastAckLen = min<uint8_t>(len, TB_MAX_AIR);
+
+    if (len >= 2 && buf[offsetof(TbAckPagedHdr, type)] == TB_ACK_PAGED) {
+      TbAckPagedView pv;
+      if (!pv.parse(buf, len)) return false;
+      _tel.apply(pv, nowMs);
+      if (pv.page() == TB_PAGE_REC) _recPull.onChunk(pv.body(), nowMs);
+      if (pv.page() == TB_PAGE_TIME) {
+        _rtt.onEcho(TbLoadLe32(pv.body() + offsetof(TbAckPageTime, token)),
+                    TbLoadLe16(pv.body() + offsetof(TbAckPageTime, apply_us)), nowMs);
+      }
+      return true;
+    }
+
+    TbAckView av;
+    if (!av.parse(buf, len)) return false;
+    _tel.apply(av, nowMs);
+    return true;
+  }
+};
+
+// ============================================================================
+// LINK MANAGER (data rate + PA adaptation over kTbLinkLevels)
+// ============================================================================
+// Every EVAL_SENDS sends it scores the window on ACK success, mean auto-retransmit
+// count (getARC) and the RX's own rxBad delta from telemetry. A bad window steps
+// one level toward robust; UP_HOLD consecutive clean windows step one level
+// toward fast/low power, with the hold doubling after each step back down.
+// Both ends switch in lockstep through TB_LINK_CFG: the switch is requested
+// here and taken in onLinkCfgDone() once the RX has acked it. With no ACK for
+// TB_LINK_LOST_MS the TX alternates fallback/boot levels until the RX answers.
+class TxLinkManager {
+public:
+  struct Switch {
+    uint32_t ms;
+    uint8_t  from;
+    uint8_t  to;
+    char     reason;   // U = up, D = down, L = lost (local fallback)
+  };
+  static constexpr uint8_t HISTORY = 8;
+
+  void begin(uint32_t nowMs) {
+    _lastOkMs = nowMs;
+    _lost = false;
+    _goodWindows = 0;
+    _upHold = UP_HOLD_MIN;
+    _haveRxBase = false;
+    _histCount = 0;
+    _histHead = 0;
+    resetWindow();
+  }
+
+  void noteSend(bool ok, uint8_t arc, uint32_t nowMs) {
+    _winSends++;
+    if (ok) {
+      _winOk++;
+      _winArc += arc;
+      _lastOkMs = nowMs;
+      _lost = false;
     }
+  }
+
+  void tick(TxRadioLink& radio, const TxTelemetry& tel, uint32_t nowMs) {
+    if (nowMs - _lastOkMs >= TB_LINK_LOST_MS) {
+      const uint8_t next = (radio.level() == TB_LINK_FALLBACK_LEVEL) ? TB_LINK_BOOT_LEVEL
+                                                                      : TB_LINK_FALLBACK_LEVEL;
+      if (!_lost) record(nowMs, radio.level(), next, 'L');
+      _lost = true;
+      radio.applyLevel(next);
+      _lastOkMs = nowMs;
+      _goodWindows = 0;
+      _haveRxBase = false;
+      resetWindow();
+      return;
+    }
+
+    if (_winSends < EVAL_SENDS) return;
+
+    const uint16_t successPct = (uint16_t)((_winOk * 100UL) / _winSends);
+    const uint16_t arcX10 = _winOk ? (uint16_t)((_winArc * 10UL) / _winOk) : 150;
+
+    uint16_t badDelta = 0;
+    uint16_t okDelta = 0;
+    if (tel.has(TxTelemetry::F_RX_BAD)) {
+      if (_haveRxBase) {
+        badDelta = (uint16_t)(tel.rxBad - _rxBadBase);
+        okDelta  = (uint16_t)(tel.rxOk - _rxOkBase);
+      }
+      _rxBadBase = tel.rxBad;
+      _rxOkBase = tel.rxOk;
+      _haveRxBase = true;
+    }
+    const bool rxBadHigh = (uint32_t)badDelta * 10UL > (uint32_t)okDelta + badDelta;
+
+    _lastSuccessPct = successPct;
+    _lastArcX10 = arcX10;
+    _lastRxBadDelta = badDelta;
+
+    const bool bad  = successPct < 90 || arcX10 >= 30 || rxBadHigh;
+    const bool good = successPct == 100 && arcX10 <= 5 && badDelta == 0;
+
+    const uint8_t level = radio.level();
+    if (bad) {
+      _goodWindows = 0;
+      if (level > 0) radio.requestLinkCfg((uint8_t)(level - 1));
+    } else if (good) {
+      if (++_goodWindows >= _upHold && level + 1 < TB_LINK_LEVELS) {
+        radio.requestLinkCfg((uint8_t)(level + 1));
+        _goodWindows = 0;
+      } else if (_goodWindows >= UP_HOLD_MIN && _upHold > UP_HOLD_MIN) {
+        _upHold--;   // clean running at this level slowly relaxes the backoff
+      }
+    } else {
+      _goodWindows = 0;
+    }
+
+    resetWindow();
+  }
+
+  // TB_LINK_CFG result: the RX switched on receipt, so follow it
+  void onLinkCfgDone(TxRadioLink& radio, uint8_t to, bool ok, uint32_t nowMs) {
+    if (!ok) return;
+    const uint8_t from = radio.level();
+    if (to == from) return;
+    radio.applyLevel(to);
+    record(nowMs, from, to, to < from ? 'D' : 'U');
+    if (to < from) _upHold = (uint8_t)min<uint16_t>((uint16_t)_upHold * 2, UP_HOLD_MAX);
+    _haveRxBase = false;
+  }
+
+  bool lost() const { return _lost; }
+  uint16_t lastSuccessPct() const { return _lastSuccessPct; }
+  uint16_t lastArcX10() const { return _lastArcX10; }
+  uint16_t lastRxBadDelta() const { return _lastRxBadDelta; }
+  uint8_t historyCount() const { return _histCount; }
+
+  // i = 0 is the most recent switch
+  const Switch& history(uint8_t i) const {
+    return _hist[(uint8_t)(_histHead + HISTORY - 1 - i) % HISTORY];
+  }
+
+private:
+  static constexpr uint16_t EVAL_SENDS  = 40;
+  static constexpr uint8_t  UP_HOLD_MIN = 3;
+  static constexpr uint8_t  UP_HOLD_MAX = 48;
+
+  uint32_t _lastOkMs = 0;
+  bool     _lost = false;
+
+  uint16_t _winSends = 0;
+  uint16_t _winOk = 0;
+  uint32_t _winArc = 0;
+
+  uint8_t  _goodWindows = 0;
+  uint8_t  _upHold = UP_HOLD_MIN;
 
-    radio.read(&outAck, sizeof(outAck));
+  bool     _haveRxBase = false;
+  uint16_t _rxBadBase = 0;
+  uint16_t _rxOkBase = 0;
 
-    if (outAck.ver != TB_VER) return false;
-    if (outAck.type != TB_ACK) return false;
+  uint16_t _lastSuccessPct = 0;
+  uint16_t _lastArcX10 = 0;
+  uint16_t _lastRxBadDelta = 0;
 
-    return (TbAckCrc(outAck) == outAck.crc16);
+  Switch  _hist[HISTORY] = {};
+  uint8_t _histCount = 0;
+  uint8_t _histHead = 0;
+
+  void resetWindow() {
+    _winSends = 0;
+    _winOk = 0;
+    _winArc = 0;
+  }
+
+  void record(uint32_t nowMs, uint8_t from, uint8_t to, char reason) {
+    Switch& sw = _hist[_histHead];
+    sw.ms = nowMs;
+    sw.from = from;
+    sw.to = to;
+    sw.reason = reason;
+    _histHead = (uint8_t)((_histHead + 1) % HISTORY);
+    if (_histCount < HISTORY) _histCount++;
+    logBothf("RF level %u -> %u (%c) %s", (unsigned int)from, (unsigned int)to, reason, TbLinkLevelName(to));
   }
 };
 
@@ -803,18 +2082,33 @@ public:
               uint8_t accIndex,
               const TxInputs& inputs,
               bool linkOk,
-              const TbAckV2& ack,
+              uint8_t rfLevel,
+              const TxTelemetry& tel,
               uint16_t vSysAvg_mV,
               uint16_t vPropAvg_mV,
               uint16_t iSysAvg_mA,
               uint32_t ackAgeMs,
-              const WifiWindowManager& wifi) {
+              const WifiWindowManager& wifi,
+              const TxRttMeter& rtt) {
     if (!_ok) return;
 
     display.clearDisplay();
     display.setTextSize(1);
     display.setTextColor(SSD1306_WHITE);
 
+    // Takes the whole screen, menu included, until the RX clears it
+    if (tel.waterAlarm()) {
+      renderWaterAlert(tel, outCmd);
+      display.display();
+      return;
+    }
+
+    if (inputs.menuPage() == TxInputs::MENU_DIAG) {
+      renderDiag(rtt);
+      display.display();
+      return;
+    }
+
     if (inputs.menuActive()) {
       renderMenu(inputs, wifi);
       display.display();
@@ -825,6 +2119,8 @@ public:
     l0 += (outCmd.arm ? "ON " : "OFF");
     l0 += "  LINK:";
     l0 += (linkOk ? "OK" : "FAIL");
+    l0 += " L";
+    l0 += String((int)rfLevel);
     printLine(0, l0);
 
     String l1 = "THR:";
@@ -853,23 +2149,29 @@ public:
     String l4 = "Isys:";
     l4 += String(iSysBuf);
     l4 += "mA  W:";
-    l4 += String(ack.waterRaw);
+    l4 += tel.has(TxTelemetry::F_WATER) ? String(tel.waterRaw) : String("--");
+    if (tel.waterSeen()) l4 += "!";   // tripped earlier, now clear
     printLine(4, l4);
 
-    String l5 = "ok:";
-    l5 += String(ack.rxOk);
-    l5 += " bad:";
-    l5 += String(ack.rxBad);
-    l5 += " age:";
-    l5 += String(ackAgeMs);
-    printLine(5, l5);
+    // Link counters and pack energy share row 5, alternating every 2 s
+    if (tel.has(TxTelemetry::F_ENERGY) && ((millis() / 2000) & 1)) {
+      printLine(5, formatEnergy(tel));
+    } else {
+      String l5 = "ok:";
+      l5 += String(tel.rxOk);
+      l5 += " bad:";
+      l5 += String(tel.rxBad);
+      l5 += " age:";
+      l5 += String(ackAgeMs);
+      printLine(5, l5);
+    }
 
     if (!wifi.isActive()) {
       printLine(6, "WiFi:OFF  Btn34/menu");
-      printLine(7, String("OTA:") + (wifi.isOtaActive() ? "ON" : "OFF"));
+      printLine(7, String("OTA:") + (wifi.isOtaActive() ? "ON" : "OFF") + "  RF:" + TbLinkLevelName(rfLevel));
     } else if (!wifi.isConnected()) {
       printLine(6, "WiFi:CONN");
-      printLine(7, String("OTA:") + (wifi.isOtaActive() ? "ON" : "OFF"));
+      printLine(7, String("OTA:") + (wifi.isOtaActive() ? "ON" : "OFF") + "  RF:" + TbLinkLevelName(rfLevel));
     } else {
       printLine(6, String("WiFi:ON OTA:") + (wifi.isOtaActive() ? "ON" : "OFF"));
 
@@ -896,6 +2198,37 @@ private:
     return String(buf);
   }
 
+  // "1234mAh 12.34Wh R1:05" (runtime h:mm, "R--" near idle)
+  static String formatEnergy(const TxTelemetry& tel) {
+    char buf[32];
+    if (tel.runtime_min == 0xFFFF) {
+      snprintf(buf, sizeof(buf), "%umAh %u.%02uWh R--",
+               (unsigned int)tel.used_mAh,
+               (unsigned int)(tel.used_cWh / 100),
+               (unsigned int)(tel.used_cWh % 100));
+    } else {
+      snprintf(buf, sizeof(buf), "%umAh %u.%02uWh R%u:%02u",
+               (unsigned int)tel.used_mAh,
+               (unsigned int)(tel.used_cWh / 100),
+               (unsigned int)(tel.used_cWh % 100),
+               (unsigned int)(tel.runtime_min / 60),
+               (unsigned int)(tel.runtime_min % 60));
+    }
+    return String(buf);
+  }
+
+  static void renderWaterAlert(const TxTelemetry& tel, const TbCmdV1& outCmd) {
+    display.fillRect(0, 0, OLED_W, OLED_H, SSD1306_WHITE);
+    display.setTextColor(SSD1306_BLACK);
+    display.setTextSize(3);
+    display.setCursor(10, 4);
+    display.print("WATER");
+    display.setTextSize(1);
+    printLine(4, String("  level:") + String(tel.waterRaw));
+    printLine(6, String("  ARM:") + (outCmd.arm ? "ON " : "OFF") + " Vsys:" + formatVolts(tel.vSys_mV));
+    display.setTextColor(SSD1306_WHITE);
+  }
+
   static void printLine(int row, const String& s) {
     display.setCursor(0, row * 8);
     display.print(s);
@@ -907,6 +2240,25 @@ private:
     display.print(label);
   }
 
+  // Delay stats in ms with 0.1 resolution: "RTT  1.2  1.9  4.8"
+  static String formatDelayRow(const char* label, uint32_t a, uint32_t b, uint32_t c) {
+    char buf[24];
+    snprintf(buf, sizeof(buf), "%-4s%5.1f%5.1f%5.1f", label, a / 1000.0f, b / 1000.0f, c / 1000.0f);
+    return String(buf);
+  }
+
+  static void renderDiag(const TxRttMeter& rtt) {
+    printLine(0, "Diagnostics (ms)");
+    printLine(1, "     min  avg  p99");
+    printLine(2, formatDelayRow("RTT", rtt.rtt().minUs(), rtt.rtt().avgUs(), rtt.rtt().p99Us()));
+    printLine(3, formatDelayRow("1way", rtt.oneWay().minUs(), rtt.oneWay().avgUs(), rtt.oneWay().p99Us()));
+    char buf[24];
+    snprintf(buf, sizeof(buf), "Jitter %5.1f", rtt.jitterUs() / 1000.0f);
+    printLine(4, String(buf));
+    printLine(5, String("Echoes ") + String((unsigned long)rtt.oneWay().count()));
+    printLine(7, "Press=back");
+  }
+
   static void renderMenu(const TxInputs& inputs, const WifiWindowManager& wifi) {
     printLine(0, String(inputs.menuTitle()));
     printLine(1, "Turn=scroll Press=sel");
@@ -944,7 +2296,7 @@ public:
     _btnWifi.begin(PIN_WIFI_BTN, false); // external pull-up
 
     const uint32_t now = millis();
-    _lastSendMs   = now;
+    _lastInputMs  = now;
     _lastOledMs   = now;
     _lastSerialMs = now;
     _lastRampMs   = now;
@@ -955,11 +2307,21 @@ public:
 
     memset(&_cmdOut, 0, sizeof(_cmdOut));
     memset(&_lastSetCmd, 0, sizeof(_lastSetCmd));
+    memset(&_lastSentCmd, 0, sizeof(_lastSentCmd));
+    _sched.begin(now);
+    _loopStat.reset(now);
 
     _radioReady = _radio.begin();
+    _linkMgr.begin(now);
     _lastRadioRetryMs = now;
 
     logBoth("TX ready (protocol v2) - KY040 table + WiFi/OTA toggles + THR/RUD ramps.");
+#if TB_CRC_BENCH
+    TbCrcBenchmark();
+#endif
+#if TB_HOP_SIM
+    TbHopSimulate();
+#endif
     if (!_radioReady) {
       logBoth("NRF24 init failed. OLED will stay alive while radio retries.");
     }
@@ -967,61 +2329,80 @@ public:
 
   void tick() {
     const uint32_t now = millis();
+    const uint32_t tickStartUs = micros();
+    uint32_t radioUs = 0;
 
     maintainRadioLink(now);
 
+    if (_radioReady) {
+      const uint32_t t0 = micros();
+      _radio.service(now);
+      radioUs += micros() - t0;
+      TxRadioLink::Done done;
+      if (_radio.takeDone(done)) onSendDone(done, now);
+    }
+
     if (_btnWifi.fell()) {
       if (_wifi.isActive()) _wifi.disable();
       else _wifi.enable();
     }
 
     _wifi.tick();
+    pollRadio();
     maintainWifiConsole();
+    pollRadio();
 
-    if (now - _lastSendMs >= SEND_PERIOD_MS) {
-      _lastSendMs = now;
+    if (now - _lastInputMs >= INPUT_PERIOD_MS) {
+      _lastInputMs = now;
 
       _inputs.update();
       handleUiActions();
-      const TbCmdV1 setCmd = _inputs.setpointCmd();
-
-      applyRamps(setCmd, now);
-
-      const bool ok = _radioReady ? _radio.sendCmd(_cmdOut) : false;
-      updateTelemetryAverage(now, ok);
+      _lastSetCmd = _inputs.setpointCmd();
 
-      if (now - _lastSerialMs >= SERIAL_PERIOD_MS) {
-        _lastSerialMs = now;
-        logOncePerSecond(ok, setCmd);
+      applyRamps(_lastSetCmd, now);
+      if (memcmp(&_cmdOut, &_lastSentCmd, sizeof(_cmdOut)) != 0) {
+        _sched.noteChange(_cmdOut.arm != _lastSentCmd.arm, micros());
       }
+    }
 
-      _lastSetCmd = setCmd;
+    if (_sched.due(now) && !(_radioReady && _radio.busy())) {
+      const uint32_t t0 = micros();
+      if (_radioReady && _radio.startCmd(_cmdOut)) {
+        _inFlightCmd = _cmdOut;
+        _cmdStartMs = now;
+      } else {
+        _cmdStartMs = now;
+        onCmdDone(false, now);
+      }
+      radioUs += micros() - t0;
+#if !TB_TX_ASYNC
+      TxRadioLink::Done done;   // the blocking write has already completed
+      if (_radio.takeDone(done)) onSendDone(done, now);
+#endif
     }
 
-    if (now - _lastOledMs >= OLED_PERIOD_MS) {
-      _lastOledMs = now;
-      const uint32_t ackAge = now - _radio.lastAckMs();
-      const TbAckV2& rawAck = _radio.lastAck();
-      uint16_t vSysOut_mV = rawAck.vSys_mV;
-      uint16_t vPropOut_mV = rawAck.vProp_mV;
-      uint16_t iSysOut_mA = rawAck.iSys_mA;
-      getDisplayTelemetry(vSysOut_mV, vPropOut_mV, iSysOut_mA);
-      _ui.render(_lastSetCmd,
-                 _cmdOut,
-                 _inputs.accIndex(),
-                 _inputs,
-                 _radio.lastSendOk(),
-                 rawAck,
-                 vSysOut_mV,
-                 vPropOut_mV,
-                 iSysOut_mA,
-                 ackAge,
-                 _wifi);
+    // Water alarm: the alert is drawn in the same pass its ACK arrived
+    uint32_t waterAckUs = 0, waterLinkUs = 0;
+    if (_radio.takeWaterAlarm(waterAckUs, waterLinkUs)) {
+      pollRadio();
+      renderOled(now);
+      pollRadio();
+      _waterLinkMs = (waterLinkUs + 500) / 1000;
+      _waterOledMs = (micros() - waterAckUs + 500) / 1000;
+      _waterAlertMs = now;
+      _waterReportPending = true;
+    } else if (now - _lastOledMs >= OLED_PERIOD_MS) {
+      pollRadio();
+      renderOled(now);
+      pollRadio();
     }
+    reportWaterAlert(now);
+
+    _loopStat.add(micros() - tickStartUs, radioUs, now);
   }
 
 private:
-  static constexpr uint32_t SEND_PERIOD_MS   = 50;
+  static constexpr uint32_t INPUT_PERIOD_MS  = 10;  // input poll + ramp step; sends via TxSendScheduler
   static constexpr uint32_t OLED_PERIOD_MS   = 200;
   static constexpr uint32_t SERIAL_PERIOD_MS = 1000;
   static constexpr uint32_t TELEMETRY_AVG_MS = 10000;
@@ -1042,7 +2423,7 @@ private:
   SlewLimiter _thrRamp;
   SlewLimiter _rudRamp;
 
-  uint32_t _lastSendMs = 0;
+  uint32_t _lastInputMs = 0;
   uint32_t _lastOledMs = 0;
   uint32_t _lastSerialMs = 0;
   uint32_t _lastRampMs = 0;
@@ -1050,6 +2431,12 @@ private:
 
   TbCmdV1 _cmdOut{};
   TbCmdV1 _lastSetCmd{};
+  TbCmdV1 _lastSentCmd{};
+  TxSendScheduler _sched;
+  TxLinkManager _linkMgr;
+  TxLoopStat _loopStat;
+  TbCmdV1  _inFlightCmd{};   // CMD on the air (TxRadioLink::startCmd)
+  uint32_t _cmdStartMs = 0;
 
   uint32_t _sumVSys_mV = 0;
   uint32_t _sumVProp_mV = 0;
@@ -1071,6 +2458,47 @@ private:
   uint8_t _consoleLineLen = 0;
   uint8_t _telnetSkipBytes = 0;
   bool _consoleTelemetryEnabled = true;
+  uint32_t _waterAlertMs = 0;
+  uint32_t _waterLinkMs = 0;
+  uint32_t _waterOledMs = 0;
+  bool _waterReportPending = false;
+
+  void renderOled(uint32_t now) {
+    _lastOledMs = now;
+    const uint32_t ackAge = now - _radio.lastAckMs();
+    const TxTelemetry& tel = _radio.telemetry();
+    uint16_t vSysOut_mV = tel.vSys_mV;
+    uint16_t vPropOut_mV = tel.vProp_mV;
+    uint16_t iSysOut_mA = tel.iSys_mA;
+    getDisplayTelemetry(vSysOut_mV, vPropOut_mV, iSysOut_mA);
+    _ui.render(_lastSetCmd,
+               _cmdOut,
+               _inputs.accIndex(),
+               _inputs,
+               _radio.lastSendOk(),
+               _radio.level(),
+               tel,
+               vSysOut_mV,
+               vPropOut_mV,
+               iSysOut_mA,
+               ackAge,
+               _wifi,
+               _radio.rtt());
+  }
+
+  // Crossing-to-alert budget, logged once the THERMAL page after the alert
+  // brings the RX share (sample over trip -> ACK re-queued)
+  void reportWaterAlert(uint32_t now) {
+    if (!_waterReportPending) return;
+    const TxTelemetry& tel = _radio.telemetry();
+    if (tel.ageMs(TxTelemetry::F_WATER, now) >= now - _waterAlertMs) return;
+    _waterReportPending = false;
+    logBothf("WATER ALARM alert: rx=%ums link<=%lums oled=%lums total<=%lums",
+             (unsigned int)tel.waterTrip_ms,
+             (unsigned long)_waterLinkMs,
+             (unsigned long)_waterOledMs,
+             (unsigned long)(tel.waterTrip_ms + _waterLinkMs + _waterOledMs));
+  }
 
   void handleUiActions() {
     switch (_inputs.consumeAction()) {
@@ -1116,10 +2544,10 @@ private:
   }
 
   void logOncePerSecond(bool lastSendOk, const TbCmdV1& setCmd) {
-    const TbAckV2& ack = _radio.lastAck();
-    uint16_t vSysOut_mV = ack.vSys_mV;
-    uint16_t vPropOut_mV = ack.vProp_mV;
-    uint16_t iSysOut_mA = ack.iSys_mA;
+    const TxTelemetry& tel = _radio.telemetry();
+    uint16_t vSysOut_mV = tel.vSys_mV;
+    uint16_t vPropOut_mV = tel.vProp_mV;
+    uint16_t iSysOut_mA = tel.iSys_mA;
     getDisplayTelemetry(vSysOut_mV, vPropOut_mV, iSysOut_mA);
     char line[256];
     snprintf(line, sizeof(line),
@@ -1136,10 +2564,11 @@ private:
     if (lastSendOk) {
       char ackBuf[128];
       snprintf(ackBuf, sizeof(ackBuf),
-               " | ACK st=%d ok=%u bad=%u Vsys(V)=%.3f Isys(mA)=%04u",
-               (int)ack.status,
-               (unsigned int)ack.rxOk,
-               (unsigned int)ack.rxBad,
+               " | ACK st=%d fs=%s ok=%u bad=%u Vsys(V)=%.3f Isys(mA)=%04u",
+               (int)(tel.status & TB_S_CODE_MASK),
+               kFsStageNames[tel.fsStage()],
+               (unsigned int)tel.rxOk,
+               (unsigned int)tel.rxBad,
                vSysOut_mV / 1000.0f,
                (unsigned int)iSysOut_mA);
       msg += ackBuf;
@@ -1165,10 +2594,10 @@ private:
 
   void updateTelemetryAverage(uint32_t now, bool sendOk) {
     if (sendOk && _radio.lastAckUpdated()) {
-      const TbAckV2& ack = _radio.lastAck();
-      _sumVSys_mV += ack.vSys_mV;
-      _sumVProp_mV += ack.vProp_mV;
-      _sumISys_mA += ack.iSys_mA;
+      const TxTelemetry& tel = _radio.telemetry();
+      _sumVSys_mV += tel.vSys_mV;
+      _sumVProp_mV += tel.vProp_mV;
+      _sumISys_mA += tel.iSys_mA;
       _avgSamples++;
     }
 
@@ -1187,6 +2616,7 @@ private:
     }
   }
 
+  // The RX filters at the source (median + IIR); the boxcar is only kept for comparison
   void getDisplayTelemetry(uint16_t& vSys_mV, uint16_t& vProp_mV, uint16_t& iSys_mA) const {
     if (!_hasAveragedTelemetry) return;
     vSys_mV = _avgVSys_mV;
@@ -1194,6 +2624,48 @@ private:
     iSys_mA = _avgISys_mA;
   }
 
+  // STATUS poll only; the Done is taken at the top of the next tick()
+  void pollRadio() {
+    if (_radioReady) _radio.poll();
+  }
+
+  void onSendDone(const TxRadioLink::Done& done, uint32_t now) {
+    switch (done.kind) {
+      case TxRadioLink::TX_CMD:
+        onCmdDone(done.ok, now);
+        break;
+      case TxRadioLink::TX_LINK_CFG:
+        _linkMgr.onLinkCfgDone(_radio, done.arg, done.ok, now);
+        break;
+      case TxRadioLink::TX_REC_REQ:
+        if (done.arg == TB_REC_OP_RESUME) {
+          consolePrintLine(done.ok ? "RX recorder resumed." : "Resume not acked; retry.");
+        }
+        break;
+      default:
+        break;
+    }
+  }
+
+  // CMD finished (or could not start): scheduler, link adaptation, logging
+  void onCmdDone(bool ok, uint32_t now) {
+    _sched.noteSent(ok, _cmdStartMs, micros());
+    if (ok) _lastSentCmd = _inFlightCmd;
+    if (_radioReady) {
+      _linkMgr.noteSend(ok, _radio.lastArc(), now);
+      _linkMgr.tick(_radio, _radio.telemetry(), now);
+    }
+
+#if TB_TEL_BOXCAR
+    updateTelemetryAverage(now, ok);
+#endif
+
+    if (now - _lastSerialMs >= SERIAL_PERIOD_MS) {
+      _lastSerialMs = now;
+      logOncePerSecond(ok, _lastSetCmd);
+    }
+  }
+
   void maintainRadioLink(uint32_t now) {
     static constexpr uint32_t RADIO_RETRY_MS = 2000;
     if (_radioReady) return;
@@ -1202,6 +2674,7 @@ private:
     _lastRadioRetryMs = now;
     _radioReady = _radio.begin();
     if (_radioReady) {
+      _linkMgr.begin(now);
       logBoth("NRF24 init recovered.");
     } else {
       Serial.println("NRF24 retry failed.");
@@ -1297,13 +2770,31 @@ private:
     consolePrintLine("");
     consolePrintLine("TugBot TX WiFi terminal");
     consolePrintLine("Commands: help, status, vars, get <name>, set <name> <value>");
-    consolePrintLine("          wifi on|off, ota on|off, telemetry on|off, reboot");
+    consolePrintLine("          wifi on|off, ota on|off, telemetry on|off, link, hop, reboot");
+    consolePrintLine("          rec [pull|dump|resume]  (RX flight recorder)");
+    consolePrintLine("          loop [reset]  (TX loop-time histogram)");
     consolePrintLine("Vars: thr_rate_up, thr_rate_down, rud_rate");
   }
 
+  void printLoopStat() {
+    consolePrintf("tx_loop mode=%s max=%luus max_1s=%luus radio_max=%luus radio_max_1s=%luus tx_timeouts=%u\r\n",
+                  TB_TX_ASYNC ? "async" : "blocking",
+                  (unsigned long)_loopStat.maxUs(),
+                  (unsigned long)_loopStat.windowMaxUs(),
+                  (unsigned long)_loopStat.radioMaxUs(),
+                  (unsigned long)_loopStat.windowRadioMaxUs(),
+                  (unsigned int)_radio.txTimeouts());
+    consolePrintf("tx_loop hist(<0.25,<0.5,<1,<2,<4,<8,<16,>=16ms)=%lu/%lu/%lu/%lu/%lu/%lu/%lu/%lu\r\n",
+                  (unsigned long)_loopStat.count(0), (unsigned long)_loopStat.count(1),
+                  (unsigned long)_loopStat.count(2), (unsigned long)_loopStat.count(3),
+                  (unsigned long)_loopStat.count(4), (unsigned long)_loopStat.count(5),
+                  (unsigned long)_loopStat.count(6), (unsigned long)_loopStat.count(7));
+  }
+
   void printConsoleStatus() {
-    const TbAckV2& ack = _radio.lastAck();
-    const uint32_t ackAge = millis() - _radio.lastAckMs();
+    const TxTelemetry& tel = _radio.telemetry();
+    const uint32_t now = millis();
+    const uint32_t ackAge = now - _radio.lastAckMs();
     consolePrintf("link=%s ackAge=%lums radioReady=%u wifi=%s ota=%s\r\n",
                   _radio.lastSendOk() ? "OK" : "FAIL",
                   (unsigned long)ackAge,
@@ -1317,17 +2808,226 @@ private:
                   (int)_lastSetCmd.rudderPct,
                   (unsigned int)_cmdOut.arm,
                   (unsigned int)_cmdOut.acc[0]);
-    consolePrintf("rx_ok=%u rx_bad=%u vsys=%umV vprop=%umV isys=%umA water=%u\r\n",
-                  (unsigned int)ack.rxOk,
-                  (unsigned int)ack.rxBad,
-                  (unsigned int)ack.vSys_mV,
-                  (unsigned int)ack.vProp_mV,
-                  (unsigned int)ack.iSys_mA,
-                  (unsigned int)ack.waterRaw);
+    consolePrintf("rx_ok=%u rx_bad=%u rx_coalesced=%u vsys=%umV vprop=%umV isys=%umA water=%u\r\n",
+                  (unsigned int)tel.rxOk,
+                  (unsigned int)tel.rxBad,
+                  (unsigned int)tel.rxCoalesced,
+                  (unsigned int)tel.vSys_mV,
+                  (unsigned int)tel.vProp_mV,
+                  (unsigned int)tel.iSys_mA,
+                  (unsigned int)tel.waterRaw);
+    consolePrintf("rx_failsafe stage=%s entries hold/ramp/neutral=%u/%u/%u last=%s/%ums cadence=%ums\r\n",
+                  kFsStageNames[tel.fsStage()],
+                  (unsigned int)tel.fsEntries[0],
+                  (unsigned int)tel.fsEntries[1],
+                  (unsigned int)tel.fsEntries[2],
+                  kFsStageNames[tel.fsLastDepth & 3],
+                  (unsigned int)tel.fsLastOut_ms,
+                  (unsigned int)tel.rxCadence_ms);
+    if (tel.waterSeen()) {
+      consolePrintf("water_alarm=%s last_alert rx=%ums link<=%lums oled=%lums\r\n",
+                    tel.waterAlarm() ? "ACTIVE" : "cleared",
+                    (unsigned int)tel.waterTrip_ms,
+                    (unsigned long)_waterLinkMs,
+                    (unsigned long)_waterOledMs);
+    }
+    consolePrintf("rx_uptime=%lus loop_avg=%uus loop_max=%uus tel_max=%uus adc_rate=%uHz acs_drift=%dmA free_sram=%uB\r\n",
+                  (unsigned long)tel.uptime_s,
+                  (unsigned int)tel.loopAvg_us,
+                  (unsigned int)tel.loopMax_us,
+                  (unsigned int)tel.telMax_us,
+                  (unsigned int)tel.adcRate_Hz,
+                  (int)tel.acsDrift_mA,
+                  (unsigned int)tel.freeSram_B);
+    consolePrintf("rx_lat mode=%s avg=%uus max=%uus irq_missed=%u hist%%(<64us..>=4ms)=%u/%u/%u/%u/%u/%u/%u/%u\r\n",
+                  tel.rxMode == TB_RX_IRQ ? "irq" : "polled",
+                  (unsigned int)tel.rxLatAvg_us,
+                  (unsigned int)tel.rxLatMax_us,
+                  (unsigned int)tel.rxIrqMissed,
+                  (unsigned int)tel.rxLatHist[0], (unsigned int)tel.rxLatHist[1],
+                  (unsigned int)tel.rxLatHist[2], (unsigned int)tel.rxLatHist[3],
+                  (unsigned int)tel.rxLatHist[4], (unsigned int)tel.rxLatHist[5],
+                  (unsigned int)tel.rxLatHist[6], (unsigned int)tel.rxLatHist[7]);
+#if TB_RTT
+    const TxRttMeter& rtt = _radio.rtt();
+    consolePrintf("rtt min/avg/p99=%lu/%lu/%luus one_way min/avg/p99=%lu/%lu/%luus jitter=%luus echoes=%lu unpaired=%u late=%u\r\n",
+                  (unsigned long)rtt.rtt().minUs(),
+                  (unsigned long)rtt.rtt().avgUs(),
+                  (unsigned long)rtt.rtt().p99Us(),
+                  (unsigned long)rtt.oneWay().minUs(),
+                  (unsigned long)rtt.oneWay().avgUs(),
+                  (unsigned long)rtt.oneWay().p99Us(),
+                  (unsigned long)rtt.jitterUs(),
+                  (unsigned long)rtt.oneWay().count(),
+                  (unsigned int)rtt.unpaired(),
+                  (unsigned int)rtt.late());
+#endif
+    char runtime[12] = "--";
+    if (tel.runtime_min != 0xFFFF) snprintf(runtime, sizeof(runtime), "%umin", (unsigned int)tel.runtime_min);
+    consolePrintf("energy used=%umAh %u.%02uWh peak=%umA avg=%umA runtime=%s\r\n",
+                  (unsigned int)tel.used_mAh,
+                  (unsigned int)(tel.used_cWh / 100),
+                  (unsigned int)(tel.used_cWh % 100),
+                  (unsigned int)tel.peak_mA,
+                  (unsigned int)tel.avg_mA,
+                  runtime);
+    consolePrintf("rx_tasks wcet_us/overruns radio=%u/%u act=%u/%u fs=%u/%u sense=%u/%u tel=%u/%u house=%u/%u\r\n",
+                  (unsigned int)tel.taskWcet_us[0], (unsigned int)tel.taskOverruns[0],
+                  (unsigned int)tel.taskWcet_us[1], (unsigned int)tel.taskOverruns[1],
+                  (unsigned int)tel.taskWcet_us[2], (unsigned int)tel.taskOverruns[2],
+                  (unsigned int)tel.taskWcet_us[3], (unsigned int)tel.taskOverruns[3],
+                  (unsigned int)tel.taskWcet_us[4], (unsigned int)tel.taskOverruns[4],
+                  (unsigned int)tel.taskWcet_us[5], (unsigned int)tel.taskOverruns[5]);
+    consolePrintf("seq tx=%u rx=%u lost=%u dup=%u reorder=%u last_win=%u/%u loss_hist%%(0,1,2,<=4,<=8,<=16,<32,32)=%u/%u/%u/%u/%u/%u/%u/%u\r\n",
+                  (unsigned int)_radio.txSeq(),
+                  (unsigned int)tel.rxExtSeq,
+                  (unsigned int)tel.seqLost,
+                  (unsigned int)tel.seqDups,
+                  (unsigned int)tel.seqReorders,
+                  (unsigned int)tel.seqLastWinLost,
+                  (unsigned int)TB_SEQ_LOSS_WIN,
+                  (unsigned int)tel.seqLossHist[0], (unsigned int)tel.seqLossHist[1],
+                  (unsigned int)tel.seqLossHist[2], (unsigned int)tel.seqLossHist[3],
+                  (unsigned int)tel.seqLossHist[4], (unsigned int)tel.seqLossHist[5],
+                  (unsigned int)tel.seqLossHist[6], (unsigned int)tel.seqLossHist[7]);
+    consolePrintf("age_ms fast=%ld link=%ld thermal=%ld system=%ld rx_lat=%ld energy=%ld sched=%ld seq=%ld\r\n",
+                  fieldAgeMs(tel, TxTelemetry::F_VSYS, now),
+                  fieldAgeMs(tel, TxTelemetry::F_RX_OK, now),
+                  fieldAgeMs(tel, TxTelemetry::F_WATER, now),
+                  fieldAgeMs(tel, TxTelemetry::F_UPTIME, now),
+                  fieldAgeMs(tel, TxTelemetry::F_RX_LAT, now),
+                  fieldAgeMs(tel, TxTelemetry::F_ENERGY, now),
+                  fieldAgeMs(tel, TxTelemetry::F_SCHED, now),
+                  fieldAgeMs(tel, TxTelemetry::F_SEQ, now));
+    consolePrintf("send=%lu/s event=%lu/s heartbeat=%lu/s lat_avg=%luus lat_max=%luus arm_lat=%luus\r\n",
+                  (unsigned long)_sched.sendsPerSec(),
+                  (unsigned long)_sched.eventPerSec(),
+                  (unsigned long)_sched.heartbeatPerSec(),
+                  (unsigned long)_sched.latencyAvgUs(),
+                  (unsigned long)_sched.latencyMaxUs(),
+                  (unsigned long)_sched.armLatencyUs());
+    consolePrintf("air=%luB/s cmd=%s\r\n",
+                  (unsigned long)_radio.airBytesPerSec(),
+                  TB_CMD_COMPACT ? "compact" : "full");
+    printLoopStat();
+    consolePrintf("rf_level=%u (%s)%s win_ok=%u%% win_arc=%u.%u win_rx_bad=%u\r\n",
+                  (unsigned int)_radio.level(),
+                  TbLinkLevelName(_radio.level()),
+                  _linkMgr.lost() ? " searching" : "",
+                  (unsigned int)_linkMgr.lastSuccessPct(),
+                  (unsigned int)(_linkMgr.lastArcX10() / 10),
+                  (unsigned int)(_linkMgr.lastArcX10() % 10),
+                  (unsigned int)_linkMgr.lastRxBadDelta());
+#if TB_HOP
+    const TbHopLeader& hop = _radio.hop();
+    consolePrintf("hop slot=%u ch=%u active=%u/%u blacklist=0x%04X%s\r\n",
+                  (unsigned int)hop.slot(),
+                  (unsigned int)hop.plan().channel(hop.slot()),
+                  (unsigned int)hop.plan().activeCount(),
+                  (unsigned int)TB_HOP_LEN,
+                  (unsigned int)hop.plan().mask(),
+                  hop.searching() ? " searching" : "");
+#else
+    consolePrintf("hop=off ch=%u\r\n", (unsigned int)RF_CHANNEL);
+#endif
     consolePrintf("telemetry=%s\r\n", _consoleTelemetryEnabled ? "on" : "off");
     printConsoleVars();
   }
 
+  void printLinkHistory() {
+    const uint32_t now = millis();
+    consolePrintf("rf_level=%u (%s)\r\n", (unsigned int)_radio.level(), TbLinkLevelName(_radio.level()));
+    if (_linkMgr.historyCount() == 0) {
+      consolePrintLine("No level switches yet.");
+      return;
+    }
+    for (uint8_t i = 0; i < _linkMgr.historyCount(); ++i) {
+      const TxLinkManager::Switch& sw = _linkMgr.history(i);
+      consolePrintf("-%lums %u -> %u (%c) %s\r\n",
+                    (unsigned long)(now - sw.ms),
+                    (unsigned int)sw.from,
+                    (unsigned int)sw.to,
+                    sw.reason,
+                    TbLinkLevelName(sw.to));
+    }
+  }
+
+  void printHopTable() {
+#if TB_HOP
+    const TbHopLeader& hop = _radio.hop();
+    const uint32_t now = millis();
+    consolePrintLine("slot ch  loss samples state");
+    for (uint8_t s = 0; s < TB_HOP_LEN; s++) {
+      char state[16];
+      if (hop.plan().active(s)) snprintf(state, sizeof(state), "%s", (s == hop.slot()) ? "active <" : "active");
+      else snprintf(state, sizeof(state), "bl %lus", (unsigned long)(hop.blacklistLeftMs(s, now) / 1000));
+      consolePrintf("%4u %3u %3u%% %7u %s\r\n",
+                    (unsigned int)s,
+                    (unsigned int)hop.plan().channel(s),
+                    (unsigned int)hop.lossPct(s),
+                    (unsigned int)hop.samples(s),
+                    state);
+    }
+#else
+    consolePrintLine("Hopping disabled (TB_HOP 0).");
+#endif
+  }
+
+  void handleRecCommand(const char* sub) {
+    const TxRecPull& pull = _radio.recPull();
+    if (sub == nullptr) {
+      static const char* const reasons[] = { "running", "failsafe", "crc", "water", "pull", "manual" };
+      consolePrintf("rec %s %u/%u B reason=%s\r\n",
+                    pull.active() ? "pulling" : (pull.timedOut() ? "timed out" : "idle"),
+                    (unsigned int)pull.received(),
+                    (unsigned int)pull.total(),
+                    pull.reason() < 6 ? reasons[pull.reason()] : "?");
+      return;
+    }
+    if (!_radioReady) {
+      consolePrintLine("Radio not ready.");
+      return;
+    }
+    if (strcmp(sub, "pull") == 0) {
+      _radio.startRecPull();
+      consolePrintLine("Pulling RX log (RX freezes it; 'rec resume' restarts recording).");
+      return;
+    }
+    if (strcmp(sub, "resume") == 0) {
+      _radio.requestRecResume();   // result printed when the frame completes (onSendDone)
+      return;
+    }
+    if (strcmp(sub, "dump") == 0) {
+      if (pull.active() || pull.received() == 0) {
+        consolePrintLine("No complete log; run 'rec pull' first.");
+        return;
+      }
+      consolePrintLine("t_ms,thr,rud,flags,vsys_mV,vprop_mV,isys_mA,tmot_cC,tesc_cC,water,rx_ok,rx_bad,loop_max_us");
+      TxRecPull::Source src(pull);
+      TbRecDecoder dec;
+      dec.begin();
+      uint32_t tick = 0;
+      uint16_t v[TB_REC_FIELDS];
+      while (dec.next(src, tick, v)) {
+        consolePrintf("%lu,%d,%d,%u,%u,%u,%u,%d,%d,%u,%u,%u,%u\r\n",
+                      (unsigned long)(tick * TB_REC_PERIOD_MS),
+                      (int)(int16_t)v[TB_REC_THR], (int)(int16_t)v[TB_REC_RUD],
+                      (unsigned int)v[TB_REC_FLAGS],
+                      (unsigned int)v[TB_REC_VSYS], (unsigned int)v[TB_REC_VPROP], (unsigned int)v[TB_REC_ISYS],
+                      (int)(int16_t)v[TB_REC_TMOTOR], (int)(int16_t)v[TB_REC_TESC],
+                      (unsigned int)v[TB_REC_WATER], (unsigned int)v[TB_REC_RXOK], (unsigned int)v[TB_REC_RXBAD],
+                      (unsigned int)v[TB_REC_LOOPMAX]);
+      }
+      return;
+    }
+    consolePrintLine("Usage: rec [pull|dump|resume]");
+  }
+
+  // -1 = never received
+  static long fieldAgeMs(const TxTelemetry& tel, TxTelemetry::Field f, uint32_t now) {
+    return tel.has(f) ? (long)tel.ageMs(f, now) : -1L;
+  }
+
   void printConsoleVars() {
     consolePrintf("thr_rate_up=%.2f\r\n", _thrRateUpPps);
     consolePrintf("thr_rate_down=%.2f\r\n", _thrRateDownPps);
@@ -1399,6 +3099,28 @@ private:
       printConsoleVars();
       return;
     }
+    if (strcmp(cmd, "link") == 0) {
+      printLinkHistory();
+      return;
+    }
+    if (strcmp(cmd, "hop") == 0) {
+      printHopTable();
+      return;
+    }
+    if (strcmp(cmd, "rec") == 0) {
+      handleRecCommand(strtok_r(nullptr, " \t", &save));
+      return;
+    }
+    if (strcmp(cmd, "loop") == 0) {
+      const char* sub = strtok_r(nullptr, " \t", &save);
+      if (sub != nullptr && strcmp(sub, "reset") == 0) {
+        _loopStat.reset(millis());
+        consolePrintLine("Loop histogram cleared.");
+        return;
+      }
+      printLoopStat();
+      return;
+    }
     if (strcmp(cmd, "get") == 0) {
       char* name = strtok_r(nullptr, " \t", &save);
       if (name == nullptr || !printVarValue(name)) {
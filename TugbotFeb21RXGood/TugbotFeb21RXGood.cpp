@@ -13,6 +13,7 @@
 #include <SPI.h>
 #include <RF24.h>
 #include <Servo.h>
+#include <EEPROM.h>
 #include <math.h>
 
 // =============================================================================
@@ -21,18 +22,53 @@
 #define TB_COUNT_BAD_ONCE  1   // 1 = count g_rxBad once per received packet (recommended)
 #define TB_SERIAL_WAIT     1   // 1 = while(!Serial) {} (your current behaviour)
 #define TB_DEBUG_PRINTS    1   // 1 = print ACS Vzero calibration
+#define TB_CRC_BACKEND     1   // 0 = bitwise, 1 = table256 (PROGMEM), 2 = nibble, 3 = slice4 (1.5 KB SRAM)
+#define TB_CRC_BENCH       0   // 1 = print CRC backend cycles/byte at boot
+#define TB_PAGED_ACK       1   // 1 = paged ACK (fast block + rotating page), 0 = fixed TbAckV2
+#define TB_HOP             1   // 1 = frequency hopping (must match TX), 0 = fixed RF_CHANNEL
+#define TB_RADIO_IRQ       1   // 1 = SPI only after the nRF24 IRQ fires, 0 = poll available() every pass
+#define TB_RX_DRAIN        1   // 1 = drain the RX FIFO each pass, apply newest CMD only; 0 = one frame per pass
+#define TB_TEL_BACKGROUND  1   // 1 = telemetry snapshot refreshed in the background, 0 = six analogReads per ACK
+#define TB_ADC_ISR         1   // 1 = free-running ADC, oversampled x16 in the ISR (no analogRead after begin), 0 = analogRead
+#define TB_ADC_FILTER      1   // 1 = per-channel median-3 + IIR on the decimated samples (kTbAdcFilter), 0 = decimated only
+#define TB_CONV_BENCH      0   // 1 = check integer/table conversions against the float model + time both at boot
+#define TB_ACT_BENCH       0   // 1 = time Actuators::apply, Arduino calls vs direct write-on-change, at boot (disarmed; toggles ACC4)
+#define TB_ACS_TRACK       1   // 1 = ACS zero from EEPROM + tracked while disarmed, 0 = 2 s blocking calibration every boot
+#define TB_ENERGY          1   // 1 = mAh/Wh integration + runtime estimate on the ENERGY ACK page (needs TB_ADC_ISR)
+#define TB_FLIGHT_REC      1   // 1 = SRAM flight recorder (2 KB ring; USB 'd' dump, TB_REC_REQ radio pull)
+#define TB_WATER_ALARM     1   // 1 = debounced water alarm: ACK status bit (re-queued at once) + bilge accessory (needs TB_ADC_ISR)
+#define TB_SCHED           1   // 1 = fixed-rate task table on a 1 kHz Timer1 tick (kTbTasks), 0 = everything every loop pass
+#ifndef TB_MOTOR_PWM16
+#define TB_MOTOR_PWM16     0   // 1 = BTS7960 on Timer4 fast PWM, 20 kHz + dither (needs RPWM rewired 4 -> 8, see MOTOR PWM), 0 = 8-bit ~490/980 Hz
+#endif
+#define TB_MOTION          1   // 1 = throttle/rudder interpolated between commands, short dropouts extrapolated then faded (MotionStage)
+#define TB_FS_GRADED       1   // 1 = failsafe stages from missed frames (hold / throttle ramp / neutral), 0 = single 500 ms cliff
+#define TB_SEQ_TRACK       1   // 1 = extended seq: drop duplicates / stale frames, count loss + reorders (SEQ ACK page)
+
+#if TB_WATER_ALARM && !TB_ADC_ISR
+#error "TB_WATER_ALARM needs TB_ADC_ISR (evaluated on every decimated sample)"
+#endif
+#if TB_ENERGY && !TB_ADC_ISR
+#error "TB_ENERGY integrates at the free-running ADC rate; enable TB_ADC_ISR"
+#endif
 
 // =============================================================================
 // CANON RX PINS (Mega)
 // =============================================================================
 static const uint8_t PIN_NRF24_CE   = 48;
 static const uint8_t PIN_NRF24_CSN  = 49;
+static const uint8_t PIN_NRF24_IRQ  = 18;  // external interrupt; nRF24 IRQ (active low)
 
 // BTS7960
 static const uint8_t PIN_BTS_LEN    = 23;
 static const uint8_t PIN_BTS_REN    = 25;
 static const uint8_t PIN_BTS_LPWM   = 6;
+#if TB_MOTOR_PWM16
+static const uint8_t PIN_BTS_RPWM   = 8;   // OC4C; rewired from 4 (OC0B is Timer0, which runs millis())
+static const uint8_t PIN_BTS_RPWM_OLD = 4;
+#else
 static const uint8_t PIN_BTS_RPWM   = 4;
+#endif
 
 // Accessories
 static const uint8_t PIN_PWM_ACC_1  = 2;
@@ -58,113 +94,538 @@ RF24 radio(PIN_NRF24_CE, PIN_NRF24_CSN);
 static const uint8_t PIPE_ADDR[6] = "tugbt"; // 5-byte on-air pipe
 static constexpr uint8_t RF_CHANNEL = 124;
 
+// nRF24 IRQ (RX_DR only): stamps the first arrival and flags the main loop.
+// Wired in both modes so the polled build still measures true arrival time.
+static volatile bool     g_rfIrqPending = false;
+static volatile uint32_t g_rfIrqUs = 0;
+
+static void TbRadioIsr() {
+  if (!g_rfIrqPending) {
+    g_rfIrqUs = micros();
+    g_rfIrqPending = true;
+  }
+}
+
+// =============================================================================
+// PROTOCOL v2 (include/TbProtocol.h)
+// =============================================================================
+#include "TbProtocol.h"
+
+// =============================================================================
+// UTIL
+// =============================================================================
+static int clampi(int v, int lo, int hi) {
+  if (v < lo) return lo;
+  if (v > hi) return hi;
+  return v;
+}
+
+// ±100 % in Q8 (motion / actuator paths)
+static int16_t clampPctQ8(int32_t v) {
+  if (v < -(100L << 8)) return -(100 << 8);
+  if (v > (100L << 8)) return 100 << 8;
+  return (int16_t)v;
+}
+
+static uint16_t TbAckCrc(const TbAckV2& a) {
+  return TbCrc16Ccitt((const uint8_t*)&a, sizeof(TbAckV2) - sizeof(uint16_t));
+}
+
+#if TB_CRC_BENCH
+// Boot-time CRC benchmark: cycles/byte per backend (micros() x F_CPU) + equivalence check
+static void TbCrcBenchmark() {
+  uint8_t buf[TB_MAX_AIR];
+  for (uint8_t i = 0; i < sizeof(buf); i++) buf[i] = (uint8_t)(i * 37 + 11);
+
+  struct Backend { const __FlashStringHelper* name; uint16_t (*fn)(const uint8_t*, size_t); };
+  const Backend backends[] = {
+    { F("bitwise "), TbCrc16Bitwise },
+    { F("table256"), TbCrc16Table256 },
+    { F("nibble  "), TbCrc16Nibble },
+    { F("slice4  "), TbCrc16Slice4 },
+  };
+
+  static constexpr uint16_t RUNS = 200;
+  const uint16_t ref = TbCrc16Bitwise(buf, sizeof(buf));
+
+  for (const Backend& b : backends) {
+    const uint16_t got = b.fn(buf, sizeof(buf)); // also builds slice4 tables before timing
+    volatile uint16_t sink = 0;
+    const uint32_t t0 = micros();
+    for (uint16_t r = 0; r < RUNS; r++) sink ^= b.fn(buf, sizeof(buf));
+    const uint32_t us = micros() - t0;
+    (void)sink;
+
+    const float cycPerByte = (float)us * (float)(F_CPU / 1000000UL) / ((float)RUNS * sizeof(buf));
+    Serial.print(F("CRC "));
+    Serial.print(b.name);
+    Serial.print(F(": "));
+    Serial.print(cycPerByte, 1);
+    Serial.print(F(" cyc/B"));
+    Serial.println(got == ref ? F("  OK") : F("  MISMATCH"));
+  }
+}
+#endif
+
 // =============================================================================
-// PROTOCOL v2
+// ADC FILTERS (fixed point, no FPU on the 2560)
 // =============================================================================
-static constexpr uint8_t TB_MAX_AIR = 32;
-static constexpr uint8_t TB_VER     = 2;
+// Values are "adc12": 10-bit samples oversampled x16 and decimated by 4, so the
+// full scale is 4092 (1023 << 2). Per channel, a median-of-3 knocks out single
+// spikes (ESC switching, servo current steps), then a first-order IIR
+//   y += (x - y) / 2^k
+// with state carried in Q4. At the ~100 Hz decimated rate the -3 dB point is
+// roughly 100 / (2*pi*2^k) Hz: k=2 -> 4 Hz, 3 -> 2 Hz, 4 -> 1 Hz, 5 -> 0.5 Hz.
+static constexpr uint8_t  TB_ADC_OS_LOG2  = 4;                     // 16 samples per output
+static constexpr uint8_t  TB_ADC_OS       = 1 << TB_ADC_OS_LOG2;
+static constexpr uint8_t  TB_ADC_EXTRA_BITS = TB_ADC_OS_LOG2 / 2;  // +2 bits
+static constexpr uint16_t TB_ADC12_MAX    = 1023u << TB_ADC_EXTRA_BITS;
+
+struct TbAdcFilterCfg {
+  uint8_t median;     // 1 = median-of-3 before the IIR
+  uint8_t iirShift;   // k above, 0 = no IIR
+};
+
+class AdcChannelFilter {
+public:
+  void begin(const TbAdcFilterCfg& cfg) {
+    _cfg = cfg;
+    _primed = false;
+  }
+
+  uint16_t push(uint16_t x) {
+    if (!_primed) {
+      _h0 = _h1 = x;
+      _y = (int32_t)x << Q;
+      _primed = true;
+    }
+
+    if (_cfg.median) {
+      const uint16_t m = median3(_h1, _h0, x);
+      _h1 = _h0;
+      _h0 = x;
+      x = m;
+    }
+
+    if (_cfg.iirShift) {
+      _y += (((int32_t)x << Q) - _y) >> _cfg.iirShift;
+    } else {
+      _y = (int32_t)x << Q;
+    }
+    return value();
+  }
+
+  uint16_t value() const { return (uint16_t)((_y + (1 << (Q - 1))) >> Q); }
+
+private:
+  static constexpr uint8_t Q = 4;
+
+  TbAdcFilterCfg _cfg {0, 0};
+  bool     _primed = false;
+  uint16_t _h0 = 0;
+  uint16_t _h1 = 0;
+  int32_t  _y = 0;
+
+  static uint16_t median3(uint16_t a, uint16_t b, uint16_t c) {
+    if (a > b) { const uint16_t t = a; a = b; b = t; }
+    if (b > c) b = c;
+    return (a > b) ? a : b;
+  }
+};
 
-enum TbMsgType : uint8_t {
-  TB_CMD  = 1,
-  TB_PING = 2,
-  TB_ACK  = 4
+// =============================================================================
+// ADC ENGINE (free-running, interrupt-driven)
+// =============================================================================
+// The ADC runs free (ADATE, ADTS = 0) at 16 MHz / 128 = 125 kHz: one conversion
+// per 104 us, rotating over the telemetry channels (~1.6 kHz each). In
+// free-running mode the next conversion has already started on the old mux when
+// ADC_vect runs, so the mux written there applies one result later; _convSlot /
+// _muxSlot track that pipeline. A8/A9 are ADC8/ADC9: MUX5 in ADCSRB selects the
+// high bank. While running, analogRead() must not be used.
+//
+// The ISR only accumulates: every TB_ADC_OS samples it posts one decimated
+// adc12 value (~100 Hz per channel). tick() runs the filters in loop context.
+static constexpr uint8_t TB_ADC_CHANNELS = 6;
+
+// One decimated sample per channel every TB_ADC_DEC_US, fixed by the ADC clock
+// (13 ADC cycles per conversion at F_CPU / 128): 9984 us at 16 MHz.
+static constexpr uint32_t TB_ADC_DEC_US =
+  (uint32_t)((uint64_t)TB_ADC_OS * TB_ADC_CHANNELS * 13u * 128u * 1000000u / F_CPU);
+
+// Raw sums for energy integration, one entry per decimated ISYS sample (VSYS is
+// decimated one slot earlier in the same round). sumIV overflows after ~256
+// samples, so they are taken every loop pass.
+struct TbAdcEnergySums {
+  uint32_t sumI;
+  uint32_t sumV;
+  uint32_t sumIV;
+  uint16_t n;
+  uint16_t peakI;
 };
 
-enum TbStatus : uint8_t {
-  TB_S_OK       = 0,
-  TB_S_BAD_VER  = 1,
-  TB_S_BAD_LEN  = 2,
-  TB_S_BAD_CRC  = 3,
-  TB_S_BAD_TYPE = 4
+enum TbAdcSlot : uint8_t {
+  TB_ADC_VSYS, TB_ADC_VPROP, TB_ADC_ISYS, TB_ADC_WATER, TB_ADC_TMOTOR, TB_ADC_TESC
 };
 
-#pragma pack(push, 1)
-struct TbHdr {
-  uint8_t ver;
-  uint8_t type;
-  uint8_t flags;
-  uint8_t seq;
-  uint8_t len;   // payload length
+static const uint8_t kTbAdcPins[TB_ADC_CHANNELS] = {
+  PIN_A_V_SYS, PIN_A_V_PROP, PIN_A_CURRENT_SYS, PIN_A_WATER, PIN_TEMP_MOTOR, PIN_TEMP_SPDCNTRL
 };
 
-struct TbCmdV1 {
-  int8_t  throttlePct;   // -100..100
-  int8_t  rudderPct;     // -100..100
-  uint8_t acc[4];        // 0..255
-  uint8_t arm;           // 0/1
+static const TbAdcFilterCfg kTbAdcFilter[TB_ADC_CHANNELS] = {
+  { 1, 3 },   // VSYS    ~2 Hz
+  { 1, 3 },   // VPROP   ~2 Hz
+  { 1, 2 },   // ISYS    ~4 Hz, stays responsive to throttle steps
+  { 1, 4 },   // WATER   ~1 Hz
+  { 1, 5 },   // TMOTOR  ~0.5 Hz
+  { 1, 5 },   // TESC    ~0.5 Hz
 };
 
-struct TbAckV2 {
-  uint8_t  ver;
-  uint8_t  type;     // TB_ACK
-  uint8_t  seqEcho;
-  uint8_t  status;
-  uint16_t rxOk;
-  uint16_t rxBad;
+class AdcEngine {
+public:
+  void begin() {
+    DIDR0 = 0;
+    DIDR2 = 0;
+    for (uint8_t i = 0; i < TB_ADC_CHANNELS; i++) {
+      const uint8_t ch = (uint8_t)(kTbAdcPins[i] - A0);
+      if (ch < 8) DIDR0 |= (uint8_t)_BV(ch);
+      else DIDR2 |= (uint8_t)_BV(ch - 8);
+#if TB_ADC_FILTER
+      _filt[i].begin(kTbAdcFilter[i]);
+#endif
+    }
+
+    _convSlot = 0;
+    _muxSlot = 0;
+    _fresh = 0;
+    _lastRateMs = millis();
+    ADCSRB = 0;   // ADTS = 0: free-running trigger
+    setMux(0);
+    ADCSRA = _BV(ADEN) | _BV(ADIF) | _BV(ADPS2) | _BV(ADPS1) | _BV(ADPS0);
+    ADCSRA |= _BV(ADATE) | _BV(ADIE) | _BV(ADSC);
+  }
+
+  // ISR context
+  void onConversion() {
+    const uint16_t v = ADC;
+    const uint8_t slot = _convSlot;
+    _acc[slot] += v;
+    if (++_accN[slot] >= TB_ADC_OS) {
+      _dec[slot] = (uint16_t)(_acc[slot] >> (TB_ADC_OS_LOG2 - TB_ADC_EXTRA_BITS));
+      _acc[slot] = 0;
+      _accN[slot] = 0;
+      _fresh |= (uint8_t)(1u << slot);
+#if TB_ENERGY
+      if (slot == TB_ADC_ISYS) {
+        const uint16_t i = _dec[TB_ADC_ISYS];
+        const uint16_t vsys = _dec[TB_ADC_VSYS];
+        _energy.sumI += i;
+        _energy.sumV += vsys;
+        _energy.sumIV += (uint32_t)i * vsys;
+        _energy.n++;
+        if (i > _energy.peakI) _energy.peakI = i;
+      }
+#endif
+    }
+    _count[slot]++;
+
+    _convSlot = _muxSlot;
+    _muxSlot = (uint8_t)((_muxSlot + 1) % TB_ADC_CHANNELS);
+    setMux(_muxSlot);
+  }
+
+  // Latest output, adc12 (0..TB_ADC12_MAX)
+  uint16_t value(uint8_t slot) const {
+#if TB_ADC_FILTER
+    return _filt[slot].value();
+#else
+    noInterrupts();
+    const uint16_t v = _dec[slot];
+    interrupts();
+    return v;
+#endif
+  }
+
+  // Latest decimated sample, unfiltered (alarm fast path)
+  uint16_t raw(uint8_t slot) const {
+    noInterrupts();
+    const uint16_t v = _dec[slot];
+    interrupts();
+    return v;
+  }
+
+  // Filters newly decimated samples; refreshes the per-channel rate once a second
+  void tick(uint32_t nowMs) {
+#if TB_ADC_FILTER
+    uint16_t dec[TB_ADC_CHANNELS];
+    noInterrupts();
+    const uint8_t fresh = _fresh;
+    _fresh = 0;
+    for (uint8_t i = 0; i < TB_ADC_CHANNELS; i++) dec[i] = _dec[i];
+    interrupts();
+    for (uint8_t i = 0; fresh && i < TB_ADC_CHANNELS; i++) {
+      if (fresh & (1u << i)) _filt[i].push(dec[i]);
+    }
+#endif
 
-  uint16_t vSys_mV;
-  uint16_t vProp_mV;
+    const uint32_t elapsed = nowMs - _lastRateMs;
+    if (elapsed < 1000) return;
+    _lastRateMs = nowMs;
 
-  uint16_t iSys_mA;  // system current
+    for (uint8_t i = 0; i < TB_ADC_CHANNELS; i++) {
+      noInterrupts();
+      const uint16_t n = _count[i];
+      _count[i] = 0;
+      interrupts();
+      _rateHz[i] = (uint16_t)(((uint32_t)n * 1000UL) / elapsed);
+    }
+  }
+
+  uint16_t rateHz(uint8_t slot) const { return _rateHz[slot]; }
+
+#if TB_ENERGY
+  void takeEnergy(TbAdcEnergySums& out) {
+    noInterrupts();
+    out = *const_cast<TbAdcEnergySums*>(&_energy);
+    _energy.sumI = _energy.sumV = _energy.sumIV = 0;
+    _energy.n = _energy.peakI = 0;
+    interrupts();
+  }
+#endif
+
+  uint16_t minRateHz() const {
+    uint16_t m = 0xFFFF;
+    for (uint8_t i = 0; i < TB_ADC_CHANNELS; i++) {
+      if (_rateHz[i] < m) m = _rateHz[i];
+    }
+    return m;
+  }
 
-  int16_t  tMotor_cC;
-  int16_t  tEsc_cC;
-  uint16_t waterRaw;
+private:
+  volatile uint16_t _acc[TB_ADC_CHANNELS] = {0};
+  volatile uint8_t  _accN[TB_ADC_CHANNELS] = {0};
+  volatile uint16_t _dec[TB_ADC_CHANNELS] = {0};
+  volatile uint8_t  _fresh = 0;
+  volatile uint16_t _count[TB_ADC_CHANNELS] = {0};
+  volatile uint8_t  _convSlot = 0;
+  volatile uint8_t  _muxSlot = 0;
+  uint16_t _rateHz[TB_ADC_CHANNELS] = {0};
+  uint32_t _lastRateMs = 0;
+#if TB_ADC_FILTER
+  AdcChannelFilter _filt[TB_ADC_CHANNELS];
+#endif
+#if TB_ENERGY
+  volatile TbAdcEnergySums _energy {};
+#endif
 
-  uint16_t crc16;
+  static void setMux(uint8_t slot) {
+    const uint8_t ch = (uint8_t)(kTbAdcPins[slot] - A0);
+    ADMUX = (uint8_t)(_BV(REFS0) | (ch & 0x07));   // AVcc reference, as analogRead(DEFAULT)
+    if (ch & 0x08) ADCSRB |= (uint8_t)_BV(MUX5);
+    else ADCSRB &= (uint8_t)~_BV(MUX5);
+  }
 };
-#pragma pack(pop)
 
-static constexpr uint8_t TB_HDR_LEN = sizeof(TbHdr);
-static constexpr uint8_t TB_CRC_LEN = 2;
-static constexpr uint8_t TB_MAX_PAY = (uint8_t)(TB_MAX_AIR - TB_HDR_LEN - TB_CRC_LEN);
-static constexpr uint8_t TB_CMD_LEN = sizeof(TbCmdV1);
+#if TB_ADC_ISR
+static AdcEngine g_adcEngine;
+
+ISR(ADC_vect) {
+  g_adcEngine.onConversion();
+}
+#endif
 
 // =============================================================================
-// UTIL
+// TELEMETRY CONVERSIONS (integer, no float on the hot path)
 // =============================================================================
-static int clampi(int v, int lo, int hi) {
-  if (v < lo) return lo;
-  if (v > hi) return hi;
-  return v;
+// All inputs are adc12. Battery volts and ACS712 current are linear, so each is
+// one 32-bit multiply by a Q16 constant. The NTC curve is a 257-entry PROGMEM
+// table of centi-degC, one entry per 16 adc12 counts, generated at compile time
+// from the same constants; linear interpolation stays within 0.05 degC of the
+// logf model over -40..110 degC and 0.3 degC over -55..150 degC. Toward the
+// rails the divider has little resolution left and the error grows to degrees;
+// the hot end saturates at 327.67 degC instead of wrapping int16, so every
+// code reads monotonic in temperature. TB_CONV_BENCH checks both on target.
+struct TbCal {
+  // --- CANON conversion constants
+  static constexpr float VREF_CAL = 5.136f;
+
+  static constexpr float VDIV_R1   = 100000.0f;
+  static constexpr float VDIV_R2   = 10000.0f;
+  static constexpr float VDIV_GAIN = (VDIV_R1 + VDIV_R2) / VDIV_R2;
+
+  static constexpr float ACS_MV_PER_A = 185.0f; // ACS712-05B
+
+  static constexpr float T_RSERIES = 10000.0f;
+  static constexpr float T_R0      = 10000.0f;
+  static constexpr float T_BETA    = 3950.0f;
+  static constexpr float T0_K      = 298.15f;
+
+  static constexpr float ADC12_MAX  = (float)TB_ADC12_MAX;               // 1023 << 2
+  static constexpr float ADC12_SPAN = (float)(1024u << TB_ADC_EXTRA_BITS);
+};
+
+// mV per adc12 count (keeps the 1024-multiplier model form), Q16
+static constexpr uint32_t TB_VBAT_MV_Q16 =
+  (uint32_t)(TbCal::VREF_CAL * 1000.0f / TbCal::ADC12_SPAN * TbCal::VDIV_GAIN * 65536.0f + 0.5f);
+// mA per adc12 count above the ACS zero, Q16
+static constexpr uint32_t TB_ACS_MA_Q16 =
+  (uint32_t)(TbCal::VREF_CAL * 1000.0f / TbCal::ADC12_MAX / (TbCal::ACS_MV_PER_A / 1000.0f) * 65536.0f + 0.5f);
+
+static_assert(((uint64_t)TB_ADC12_MAX * TB_VBAT_MV_Q16 + 0x8000u) >> 16 <= 0xFFFFu, "vBat mV overflows uint16");
+static_assert((uint64_t)TB_ADC12_MAX * TB_ACS_MA_Q16 + 0x8000u <= 0xFFFFFFFFu, "ACS product overflows uint32");
+
+// C++11 constexpr natural log: halve/double into [1,2), then 2*atanh((m-1)/(m+1))
+static constexpr double TB_LN2 = 0.6931471805599453;
+static constexpr double TbCxAtanhSeries(double y, double y2, uint8_t k) {
+  return k >= 16 ? 0.0 : y / (2 * k + 1) + TbCxAtanhSeries(y * y2, y2, (uint8_t)(k + 1));
+}
+static constexpr double TbCxLnUnit(double m) {
+  return 2.0 * TbCxAtanhSeries((m - 1) / (m + 1), ((m - 1) / (m + 1)) * ((m - 1) / (m + 1)), 0);
+}
+static constexpr double TbCxLn(double x) {
+  return x >= 2.0 ? TbCxLn(x / 2.0) + TB_LN2 : x < 1.0 ? TbCxLn(x * 2.0) - TB_LN2 : TbCxLnUnit(x);
 }
 
-// CRC16-CCITT (0x1021), init 0xFFFF
-static uint16_t TbCrc16Ccitt(const uint8_t* data, size_t len) {
-  uint16_t crc = 0xFFFF;
-  for (size_t i = 0; i < len; i++) {
-    crc ^= (uint16_t)data[i] << 8;
-    for (uint8_t b = 0; b < 8; b++) {
-      crc = (crc & 0x8000) ? (uint16_t)((crc << 1) ^ 0x1021) : (uint16_t)(crc << 1);
-    }
-  }
-  return crc;
+static constexpr uint8_t  TB_NTC_STEP_LOG2 = 4;
+static constexpr uint16_t TB_NTC_ENTRIES   = (4096u >> TB_NTC_STEP_LOG2) + 1;
+
+static constexpr double TbCxNtcKelvin(double adc) {
+  // NTC on top: VREF cancels, r_ntc = RSERIES * (ADC_MAX / adc - 1)
+  return 1.0 / (1.0 / TbCal::T0_K +
+                TbCxLn(TbCal::T_RSERIES * (TbCal::ADC12_MAX / adc - 1.0) / TbCal::T_R0) / TbCal::T_BETA);
+}
+static constexpr double TbCxClampAdc(double adc) {
+  return adc < 1.0 ? 1.0 : adc > TbCal::ADC12_MAX - 1.0 ? TbCal::ADC12_MAX - 1.0 : adc;
+}
+static constexpr int16_t TbCxRoundCenti(double c) {
+  return c >= 327.67 ? (int16_t)32767 : c <= -327.68 ? (int16_t)-32768 :
+         (int16_t)(c >= 0 ? c * 100.0 + 0.5 : c * 100.0 - 0.5);
+}
+static constexpr int16_t TbCxNtcEntry(uint16_t i) {
+  return TbCxRoundCenti(TbCxNtcKelvin(TbCxClampAdc((double)((uint32_t)i << TB_NTC_STEP_LOG2))) - 273.15);
 }
 
-static uint16_t TbAckCrc(const TbAckV2& a) {
-  return TbCrc16Ccitt((const uint8_t*)&a, sizeof(TbAckV2) - sizeof(uint16_t));
+// Index pack (no std::integer_sequence in gnu++11)
+template <uint16_t... I> struct TbSeq {};
+template <uint16_t N, uint16_t... I> struct TbMakeSeq : TbMakeSeq<(uint16_t)(N - 1), (uint16_t)(N - 1), I...> {};
+template <uint16_t... I> struct TbMakeSeq<0, I...> { typedef TbSeq<I...> type; };
+
+template <typename S> struct TbNtcTable;
+template <uint16_t... I> struct TbNtcTable<TbSeq<I...> > {
+  static const int16_t data[sizeof...(I)];
+};
+template <uint16_t... I>
+const int16_t TbNtcTable<TbSeq<I...> >::data[sizeof...(I)] PROGMEM = { TbCxNtcEntry(I)... };
+
+typedef TbNtcTable<TbMakeSeq<TB_NTC_ENTRIES>::type> TbNtcCentiTable;
+
+static inline uint16_t TbBatteryMilliVolts(uint16_t adc12) {
+  return (uint16_t)(((uint32_t)adc12 * TB_VBAT_MV_Q16 + 0x8000u) >> 16);
+}
+
+// ACK field is unsigned: clamp negative to 0 for now
+static inline uint16_t TbAcsMilliAmps(uint16_t adc12, uint16_t zero12) {
+  if (adc12 <= zero12) return 0;
+  const uint32_t mA = ((uint32_t)(adc12 - zero12) * TB_ACS_MA_Q16 + 0x8000u) >> 16;
+  return (uint16_t)(mA > 65535u ? 65535u : mA);
+}
+
+// No offset applied. Rails (open/shorted NTC) return false, as the NaN path did.
+static inline bool TbNtcCentiC(uint16_t adc12, int16_t& outCentiC) {
+  if (adc12 == 0 || adc12 >= TB_ADC12_MAX) return false;
+  const uint16_t i = adc12 >> TB_NTC_STEP_LOG2;
+  const uint8_t  f = (uint8_t)(adc12 & ((1u << TB_NTC_STEP_LOG2) - 1));
+  const int16_t a = (int16_t)pgm_read_word(&TbNtcCentiTable::data[i]);
+  const int16_t b = (int16_t)pgm_read_word(&TbNtcCentiTable::data[i + 1]);
+  outCentiC = (int16_t)(a + (((int32_t)(b - a) * f + (1 << (TB_NTC_STEP_LOG2 - 1))) >> TB_NTC_STEP_LOG2));
+  return true;
 }
 
-static TbStatus TbParseFrame(const uint8_t* frame, uint8_t frameLen,
-                             TbHdr& outHdr, const uint8_t*& outPayload, uint8_t& outPayLen) {
-  if (frameLen < TB_HDR_LEN + TB_CRC_LEN) return TB_S_BAD_LEN;
+#if TB_CONV_BENCH
+// Float reference (the previous sampler code), kept only for the benchmark
+static uint16_t TbRefBatteryMilliVolts(uint16_t adc) {
+  const float vBat = (float)adc * (TbCal::VREF_CAL / TbCal::ADC12_SPAN) * TbCal::VDIV_GAIN;
+  long mv = (long)(vBat * 1000.0f + 0.5f);
+  if (mv < 0) mv = 0;
+  if (mv > 65535) mv = 65535;
+  return (uint16_t)mv;
+}
 
-  memcpy(&outHdr, frame, TB_HDR_LEN);
-  if (outHdr.ver != TB_VER) return TB_S_BAD_VER;
+static float TbRefAcsMilliAmps(uint16_t adc, float vZero) {
+  const float v = (float)adc * (TbCal::VREF_CAL / TbCal::ADC12_MAX);
+  return (v - vZero) / (TbCal::ACS_MV_PER_A / 1000.0f) * 1000.0f;
+}
 
-  const uint8_t expected = (uint8_t)(TB_HDR_LEN + outHdr.len + TB_CRC_LEN);
-  if (expected != frameLen) return TB_S_BAD_LEN;
-  if (outHdr.len > TB_MAX_PAY) return TB_S_BAD_LEN;
+static float TbRefNtcC(uint16_t adc) {
+  const float v = (float)adc * (TbCal::VREF_CAL / TbCal::ADC12_MAX);
+  const float r_ntc = TbCal::T_RSERIES * (TbCal::VREF_CAL / v - 1.0f); // NTC on top
+  const float invT = (1.0f / TbCal::T0_K) + (1.0f / TbCal::T_BETA) * logf(r_ntc / TbCal::T_R0);
+  return 1.0f / invT - 273.15f;
+}
 
-  const uint8_t totalNoCrc = (uint8_t)(TB_HDR_LEN + outHdr.len);
-  const uint16_t got = (uint16_t)frame[totalNoCrc + 0] | ((uint16_t)frame[totalNoCrc + 1] << 8);
-  const uint16_t cal = TbCrc16Ccitt(frame, totalNoCrc);
-  if (got != cal) return TB_S_BAD_CRC;
+// Boot-time check: max error vs the float model over every adc12 code, then cycles per
+// conversion set (ntc + isys + vbat) for each path
+static void TbConvBenchmark() {
+  static constexpr uint16_t ZERO12 = 512u << TB_ADC_EXTRA_BITS;
+  const float vZero = (float)ZERO12 * (TbCal::VREF_CAL / TbCal::ADC12_MAX);
+  float errMv = 0, errMa = 0, errC = 0, errWideC = 0;
+  int16_t prevC = -32768;
+  bool monotonic = true;
+  for (uint16_t a = 1; a < TB_ADC12_MAX; a++) {
+    const float dv = fabsf((float)TbBatteryMilliVolts(a) - (float)TbRefBatteryMilliVolts(a));
+    if (dv > errMv) errMv = dv;
+
+    if (a > ZERO12) {
+      const float di = fabsf((float)TbAcsMilliAmps(a, ZERO12) - TbRefAcsMilliAmps(a, vZero));
+      if (di > errMa) errMa = di;
+    }
 
-  outPayload = frame + TB_HDR_LEN;
-  outPayLen  = outHdr.len;
-  return TB_S_OK;
+    // Every code, clamped ends included: no wrap, and the bands in the header
+    const float ref = TbRefNtcC(a);
+    int16_t cC = 0;
+    if (!TbNtcCentiC(a, cC) || cC < prevC) monotonic = false;
+    prevC = cC;
+    const float dc = fabsf((float)cC / 100.0f - ref);
+    if (ref >= -40.0f && ref <= 110.0f && dc > errC) errC = dc;
+    if (ref >= -55.0f && ref <= 150.0f && dc > errWideC) errWideC = dc;
+  }
+  Serial.print(F("CONV max err: vbat="));
+  Serial.print(errMv, 2);
+  Serial.print(F("mV isys="));
+  Serial.print(errMa, 2);
+  Serial.print(F("mA ntc="));
+  Serial.print(errC, 3);
+  Serial.print(F("C (wide "));
+  Serial.print(errWideC, 3);
+  Serial.print(monotonic ? F("C)") : F("C, NOT MONOTONIC)"));
+  Serial.println(errMv <= 1.0f && errC <= 0.05f && errWideC <= 0.3f && monotonic ? F("  OK") : F("  OUT OF SPEC"));
+
+  static constexpr uint16_t RUNS = 256;
+  volatile float fsink = 0;
+  volatile int32_t isink = 0;
+  uint32_t t0 = micros();
+  for (uint16_t r = 0; r < RUNS; r++) {
+    const uint16_t a = (uint16_t)(1000 + r * 8);
+    fsink += TbRefNtcC(a) + TbRefAcsMilliAmps(a, vZero) + TbRefBatteryMilliVolts(a);
+  }
+  const uint32_t floatUs = micros() - t0;
+  t0 = micros();
+  for (uint16_t r = 0; r < RUNS; r++) {
+    const uint16_t a = (uint16_t)(1000 + r * 8);
+    int16_t cC = 0;
+    TbNtcCentiC(a, cC);
+    isink += cC + TbAcsMilliAmps(a, ZERO12) + TbBatteryMilliVolts(a);
+  }
+  const uint32_t intUs = micros() - t0;
+  (void)fsink;
+  (void)isink;
+
+  const float cyc = (float)(F_CPU / 1000000UL) / RUNS;
+  Serial.print(F("CONV cyc/set: float="));
+  Serial.print((float)floatUs * cyc, 0);
+  Serial.print(F(" int="));
+  Serial.println((float)intUs * cyc, 0);
 }
+#endif
 
 // =============================================================================
 // TELEMETRY SAMPLER (CANON)
@@ -178,95 +639,279 @@ struct Telemetry {
   uint16_t waterRaw = 0;
 };
 
-class TelemetrySampler {
+// Firmware-side stats shipped on the SYSTEM ACK page
+struct RxStats {
+  uint32_t uptime_s = 0;
+  uint16_t loopAvg_us = 0;
+  uint16_t loopMax_us = 0;
+  uint16_t telMax_us = 0;
+  uint16_t adcRate_Hz = 0;   // slowest telemetry channel, achieved samples/s
+  int16_t  acsDrift_mA = 0;  // ACS zero movement since boot
+  uint16_t freeSram_B = 0;
+  uint16_t waterTrip_ms = 0; // WaterAlarm: crossing -> ACK re-queued
+
+  uint8_t  fsEntries[3] = {0};   // Failsafe: HOLD / RAMP / NEUTRAL
+  uint8_t  fsLastDepth = 0;
+  uint16_t fsLastOut_ms = 0;
+  uint8_t  cadence_ms = 0;
+
+  uint16_t used_mAh = 0;     // EnergyMeter
+  uint16_t used_cWh = 0;
+  uint16_t peak_mA = 0;
+  uint16_t avg_mA = 0;
+  uint16_t runtime_min = 0xFFFF;
+
+  uint16_t latAvg_us = 0;    // radio arrival -> Actuators::apply
+  uint16_t latMax_us = 0;
+  uint8_t  latHist[8] = {0};
+
+  uint16_t taskWcet_us[TB_SCHED_TASKS] = {0};   // TaskScheduler
+  uint8_t  taskOverruns[TB_SCHED_TASKS] = {0};
+
+  uint16_t seqExt = 0;       // SeqTracker
+  uint16_t seqLost = 0;
+  uint16_t seqDups = 0;
+  uint16_t seqReorders = 0;
+  uint8_t  seqLossHist[8] = {0};
+  uint8_t  seqLastWinLost = 0;
+};
+
+// Signed mA for an adc12 delta (drift reporting; the ACK current stays unsigned)
+static inline int16_t TbAcsDeltaMilliAmps(int16_t dAdc12) {
+  const int32_t mA = ((int32_t)dAdc12 * (int32_t)TB_ACS_MA_Q16 + 0x8000) >> 16;
+  return (int16_t)(mA > 32767 ? 32767 : mA < -32768 ? -32768 : mA);
+}
+
+#if TB_ACS_TRACK
+// ACS712 zero: seeded from EEPROM (instant boot), then nudged toward the raw
+// reading while the vessel has been disarmed for SETTLE_MS and the reading sits
+// within WINDOW of the current estimate, so Hall thermal drift is followed over
+// a session while real load steps are never absorbed. The estimate is Q8 adc12.
+// It is written back (EEPROM.put only rewrites changed bytes) while disarmed,
+// once it has moved SAVE_DELTA counts, at most every SAVE_MIN_MS.
+class AcsZeroTracker {
 public:
-  void begin() {
-    calibrateAcsZero(2000);
+  // false = no valid record; caller calibrates and calls seed()
+  bool begin() {
+    Record r {};
+    EEPROM.get(EE_ADDR, r);
+    if (r.magic != MAGIC || r.zeroInv != (uint16_t)~r.zero12 || r.zero12 == 0 || r.zero12 >= TB_ADC12_MAX) {
+      return false;
+    }
+    reset(r.zero12);
+    return true;
   }
 
-  Telemetry read() {
-    const uint16_t adcVsys   = analogRead(PIN_A_V_SYS);
-    const uint16_t adcVprop  = analogRead(PIN_A_V_PROP);
-    const uint16_t adcIsys   = analogRead(PIN_A_CURRENT_SYS);
-    const uint16_t adcWater  = analogRead(PIN_A_WATER);
-    const uint16_t adcTMotor = analogRead(PIN_TEMP_MOTOR);
-    const uint16_t adcTEsc   = analogRead(PIN_TEMP_SPDCNTRL);
+  void seed(uint16_t zero12) {
+    reset(zero12);
+    save();
+  }
 
-    Telemetry t;
-    t.vSys_mV  = adcToBatteryMilliVolts(adcVsys);
-    t.vProp_mV = adcToBatteryMilliVolts(adcVprop);
-    t.iSys_mA  = adcToSystemMilliAmpsAcs712(adcIsys);
+  void noteArmed(bool armed, uint32_t nowMs) {
+    if (armed) {
+      _armed = true;
+    } else if (_armed) {
+      _armed = false;
+      _disarmedMs = nowMs;
+    }
+    _nowMs = nowMs;
+  }
 
-    const float motC = adcToTempC_NoOffset(adcTMotor) + T_MOTOR_OFFSET_C;
-    const float escC = adcToTempC_NoOffset(adcTEsc)   + T_ESC_OFFSET_C;
-    t.tMotor_cC = tempCToCentiDegC(motC);
-    t.tEsc_cC   = tempCToCentiDegC(escC);
+  void track(uint16_t adc12) {
+    if (!quiet()) return;
+    const int16_t d = (int16_t)(adc12 - zero12());
+    if (d > WINDOW || d < -WINDOW) return;
 
-    t.waterRaw = adcWater;
-    return t;
+    _zeroQ8 += (((int32_t)adc12 << 8) - _zeroQ8) >> TRACK_SHIFT;
+
+    const int16_t moved = (int16_t)(zero12() - _saved12);
+    if ((moved >= SAVE_DELTA || moved <= -SAVE_DELTA) && _nowMs - _lastSaveMs >= SAVE_MIN_MS) {
+      save();
+    }
   }
 
-private:
-  // --- CANON conversion constants
-  static constexpr float VREF_CAL = 5.136f;
+  uint16_t zero12() const { return (uint16_t)((_zeroQ8 + 0x80) >> 8); }
 
-  static constexpr float VDIV_R1   = 100000.0f;
-  static constexpr float VDIV_R2   = 10000.0f;
-  static constexpr float VDIV_GAIN = (VDIV_R1 + VDIV_R2) / VDIV_R2;
+  // Drift since boot, mA (positive = sensor zero crept up)
+  int16_t driftMilliAmps() const { return TbAcsDeltaMilliAmps((int16_t)(zero12() - _boot12)); }
 
-  static constexpr float ACS_MV_PER_A = 185.0f; // ACS712-05B
-  float _acsVzero = 2.50f;
+private:
+  struct Record {
+    uint16_t magic;
+    uint16_t zero12;
+    uint16_t zeroInv;
+  };
+
+  static constexpr int      EE_ADDR     = 0;
+  static constexpr uint16_t MAGIC       = 0xAC5B;
+  static constexpr uint32_t SETTLE_MS   = 2000;     // ESC and filters settled after disarm
+  static constexpr int16_t  WINDOW      = 40;       // adc12, ~270 mA
+  static constexpr uint8_t  TRACK_SHIFT = 7;        // ~3 s time constant at one sample per 24 ms round
+  static constexpr int16_t  SAVE_DELTA  = 3;        // adc12, ~20 mA
+  static constexpr uint32_t SAVE_MIN_MS = 60000;
+
+  int32_t  _zeroQ8 = (int32_t)2048 << 8;
+  uint16_t _boot12 = 2048;
+  uint16_t _saved12 = 2048;
+  bool     _armed = false;
+  uint32_t _disarmedMs = 0;
+  uint32_t _nowMs = 0;
+  uint32_t _lastSaveMs = 0;
+
+  bool quiet() const { return !_armed && (_nowMs - _disarmedMs) >= SETTLE_MS; }
+
+  void reset(uint16_t zero12) {
+    _zeroQ8 = (int32_t)zero12 << 8;
+    _boot12 = zero12;
+    _saved12 = zero12;
+    _armed = false;
+    _disarmedMs = millis();
+    _nowMs = _disarmedMs;
+    _lastSaveMs = _disarmedMs;
+  }
 
-  static constexpr float T_RSERIES = 10000.0f;
-  static constexpr float T_R0      = 10000.0f;
-  static constexpr float T_BETA    = 3950.0f;
-  static constexpr float T0_K      = 298.15f;
+  void save() {
+    const Record r { MAGIC, zero12(), (uint16_t)~zero12() };
+    EEPROM.put(EE_ADDR, r);
+    _saved12 = r.zero12;
+    _lastSaveMs = _nowMs;
+  }
+};
+#endif
+
+class TelemetrySampler {
+public:
+  void begin() {
+#if TB_ACS_TRACK
+    // Instant boot from the stored zero; first boot (blank EEPROM) calibrates once
+    if (_acs.begin()) {
+      _acsZero12 = _acs.zero12();
+#if TB_DEBUG_PRINTS
+      Serial.print(F("ACS712-05B Vzero from EEPROM: adc="));
+      Serial.println(_acsZero12);
+#endif
+    } else {
+      calibrateAcsZero(2000);
+      _acs.seed(_acsZero12);
+    }
+#else
+    calibrateAcsZero(2000);
+#endif
+#if TB_ADC_ISR
+    // Calibration above still uses analogRead; the engine owns the ADC from here
+    g_adcEngine.begin();
+    delay(12);  // one decimated output per channel (16 x 6 x 104 us = 10 ms)
+    g_adcEngine.tick(millis());
+#endif
+#if TB_TEL_BACKGROUND
+    _buf[0] = read();
+    _buf[1] = _buf[0];
+    _front = 0;
+    _next = 0;
+    _lastSlotMs = millis();
+#endif
+  }
 
-  static constexpr float T_MOTOR_OFFSET_C = -2.754f;
-  static constexpr float T_ESC_OFFSET_C   = -3.615f;
+  // Blocking: all six channels now
+  Telemetry read() {
+    Telemetry t;
+    for (uint8_t ch = 0; ch < TB_ADC_CHANNELS; ch++) sampleChannel(ch, t);
+    return t;
+  }
 
-  static float adcToVolts(uint16_t adc) {
-    return (float)adc * (VREF_CAL / 1023.0f);
+#if TB_TEL_BACKGROUND
+  // One channel per SLOT_MS into the back buffer. A finished round is
+  // published by flipping _front, so snapshot() is always one consistent
+  // round and costs the caller a struct copy, never an ADC conversion.
+  void tick(uint32_t nowMs) {
+    if (nowMs - _lastSlotMs < SLOT_MS) return;
+    _lastSlotMs = nowMs;
+
+    sampleChannel(_next, _buf[_front ^ 1]);
+    if (++_next >= TB_ADC_CHANNELS) {
+      _next = 0;
+      _front ^= 1;
+    }
   }
 
-  // Keep your preferred model form (uses 1024 in the multiplier)
-  static uint16_t adcToBatteryMilliVolts(uint16_t adc) {
-    const float vBat = (float)adc * (VREF_CAL / 1024.0f) * VDIV_GAIN;
-    long mv = (long)(vBat * 1000.0f + 0.5f);
-    if (mv < 0) mv = 0;
-    if (mv > 65535) mv = 65535;
-    return (uint16_t)mv;
+  const Telemetry& snapshot() const { return _buf[_front]; }
+#endif
+
+  // Zero tracking runs only while disarmed (and settled)
+  void noteArmed(bool armed, uint32_t nowMs) {
+#if TB_ACS_TRACK
+    _acs.noteArmed(armed, nowMs);
+#else
+    (void)armed;
+    (void)nowMs;
+#endif
   }
 
-  uint16_t adcToSystemMilliAmpsAcs712(uint16_t adc) {
-    const float v = adcToVolts(adc);
-    const float sens = ACS_MV_PER_A / 1000.0f; // V/A
-    const float amps = (v - _acsVzero) / sens;
+  uint16_t acsZero12() const { return _acsZero12; }
 
-    // ACK field is unsigned: clamp negative to 0 for now
-    long mA = (long)(amps * 1000.0f + (amps >= 0 ? 0.5f : -0.5f));
-    if (mA < 0) mA = 0;
-    if (mA > 65535) mA = 65535;
-    return (uint16_t)mA;
+  int16_t acsDriftMilliAmps() const {
+#if TB_ACS_TRACK
+    return _acs.driftMilliAmps();
+#else
+    return 0;
+#endif
   }
 
-  static float adcToTempC_NoOffset(uint16_t adc) {
-    if (adc == 0 || adc >= 1023) return NAN;
+private:
+#if TB_TEL_BACKGROUND
+  static constexpr uint32_t SLOT_MS = 4;   // full snapshot every 24 ms
+  Telemetry _buf[2];
+  uint8_t   _front = 0;
+  uint8_t   _next = 0;
+  uint32_t  _lastSlotMs = 0;
+#endif
 
-    const float v = adcToVolts(adc);
-    const float r_ntc = T_RSERIES * (VREF_CAL / v - 1.0f); // NTC on top
+  // adc12 scale either way. Non-blocking with TB_ADC_ISR (oversampled + filtered).
+  static uint16_t adc(uint8_t slot) {
+#if TB_ADC_ISR
+    return g_adcEngine.value(slot);
+#else
+    return (uint16_t)(analogRead(kTbAdcPins[slot]) << TB_ADC_EXTRA_BITS);
+#endif
+  }
 
-    const float invT = (1.0f / T0_K) + (1.0f / T_BETA) * logf(r_ntc / T_R0);
-    const float T = 1.0f / invT;
-    return T - 273.15f;
+  void sampleChannel(uint8_t slot, Telemetry& t) {
+    switch (slot) {
+      case TB_ADC_VSYS:   t.vSys_mV  = TbBatteryMilliVolts(adc(TB_ADC_VSYS)); break;
+      case TB_ADC_VPROP:  t.vProp_mV = TbBatteryMilliVolts(adc(TB_ADC_VPROP)); break;
+      case TB_ADC_ISYS: {
+        const uint16_t a = adc(TB_ADC_ISYS);
+#if TB_ACS_TRACK
+        _acs.track(a);
+        _acsZero12 = _acs.zero12();
+#endif
+        t.iSys_mA = TbAcsMilliAmps(a, _acsZero12);
+        break;
+      }
+      case TB_ADC_WATER:  t.waterRaw = (uint16_t)(adc(TB_ADC_WATER) >> TB_ADC_EXTRA_BITS); break;   // on-air stays 10-bit
+      case TB_ADC_TMOTOR:
+        t.tMotor_cC = ntcWithOffset(adc(TB_ADC_TMOTOR), T_MOTOR_OFFSET_CC);
+        break;
+      case TB_ADC_TESC:
+        t.tEsc_cC = ntcWithOffset(adc(TB_ADC_TESC), T_ESC_OFFSET_CC);
+        break;
+      default:
+        break;
+    }
   }
 
-  static int16_t tempCToCentiDegC(float tC) {
-    if (isnan(tC)) return 0;
-    long cC = (long)(tC * 100.0f + (tC >= 0 ? 0.5f : -0.5f));
-    if (cC < -32768) cC = -32768;
-    if (cC >  32767) cC =  32767;
-    return (int16_t)cC;
+  static constexpr int16_t T_MOTOR_OFFSET_CC = TbCxRoundCenti(-2.754);
+  static constexpr int16_t T_ESC_OFFSET_CC   = TbCxRoundCenti(-3.615);
+
+  uint16_t _acsZero12 = 2048;   // ~2.50 V until calibrated
+#if TB_ACS_TRACK
+  AcsZeroTracker _acs;
+#endif
+
+  static int16_t ntcWithOffset(uint16_t adc12, int16_t offsetCentiC) {
+    int16_t cC = 0;
+    if (!TbNtcCentiC(adc12, cC)) return 0;
+    return (int16_t)(cC + offsetCentiC);
   }
 
   void calibrateAcsZero(uint16_t ms) {
@@ -280,118 +925,832 @@ private:
       delay(2);
     }
 
-    const uint16_t adcAvg = (n ? (uint16_t)(acc / n) : 512);
-    _acsVzero = adcToVolts(adcAvg);
+    // Averaging gives the extra bits here too
+    const uint16_t adcAvg = (n ? (uint16_t)((acc << TB_ADC_EXTRA_BITS) / n) : (512u << TB_ADC_EXTRA_BITS));
+    _acsZero12 = adcAvg;
 
 #if TB_DEBUG_PRINTS
     Serial.print(F("ACS712-05B Vzero calibrated: adc="));
     Serial.print(adcAvg);
     Serial.print(F("  Vzero="));
-    Serial.println(_acsVzero, 4);
+    Serial.println((float)adcAvg * (TbCal::VREF_CAL / TbCal::ADC12_MAX), 4);
 #endif
   }
 };
 
 // =============================================================================
-// ACTUATORS
+// ENERGY METER (system pack: iSys x vSys)
 // =============================================================================
-class Actuators {
+// Integrates per decimated ADC sample, so dt is the ADC clock's TB_ADC_DEC_US
+// and the totals do not depend on loop speed. The ISR sums are drained every
+// pass and folded into the session totals once a second (64-bit, integer only):
+//   charge: sum(I - zero)          -> mA x samples
+//   energy: sum(I x V) - zero x sum(V) -> mW x samples
+// A second that nets below the ACS zero (idle noise) adds nothing.
+#if TB_ENERGY
+class EnergyMeter {
 public:
-  void begin() {
-    // Outputs
-    pinMode(PIN_BTS_LEN, OUTPUT);
-    pinMode(PIN_BTS_REN, OUTPUT);
-    pinMode(PIN_BTS_LPWM, OUTPUT);
-    pinMode(PIN_BTS_RPWM, OUTPUT);
-
-    digitalWrite(PIN_BTS_LEN, LOW);
-    digitalWrite(PIN_BTS_REN, LOW);
-    analogWrite(PIN_BTS_LPWM, 0);
-    analogWrite(PIN_BTS_RPWM, 0);
-
-    pinMode(PIN_PWM_ACC_1, OUTPUT);
-    pinMode(PIN_PWM_ACC_2, OUTPUT);
-    pinMode(PIN_PWM_ACC_3, OUTPUT);
-    pinMode(PIN_PWM_ACC_4, OUTPUT);
-
-    analogWrite(PIN_PWM_ACC_1, 0);
-    analogWrite(PIN_PWM_ACC_2, 0);
-    analogWrite(PIN_PWM_ACC_3, 0);
-    analogWrite(PIN_PWM_ACC_4, 0);
+  void begin(uint32_t nowMs) {
+    _lastFoldMs = nowMs;
+  }
 
-    _rudder.attach(PIN_RUDDER_SERVO);
-    _rudder.writeMicroseconds(SERVO_US_CENTER);
+  void tick(uint32_t nowMs, uint16_t zero12) {
+    TbAdcEnergySums s;
+    g_adcEngine.takeEnergy(s);
+    _pI += s.sumI;
+    _pV += s.sumV;
+    _pIV += s.sumIV;
+    _pN += s.n;
+    if (s.n && s.peakI > zero12) {
+      const uint16_t peak = TbAcsMilliAmps(s.peakI, zero12);
+      if (peak > _peak_mA) _peak_mA = peak;
+    }
+
+    if (nowMs - _lastFoldMs < FOLD_MS) return;
+    _lastFoldMs = nowMs;
+    fold(zero12);
   }
 
-  void apply(const TbCmdV1& cmd, bool armed) {
-    drivePropulsion(cmd.throttlePct, armed);
-    driveRudder(cmd.rudderPct, armed);
-    driveAccessories(cmd.acc, armed);
+  void fill(RxStats& stats) const {
+    stats.used_mAh    = clamp16(_qMaSamples * TB_ADC_DEC_US / 3600000000ULL);
+    stats.used_cWh    = clamp16(_eMwSamples * TB_ADC_DEC_US / 36000000000ULL);   // 10 mWh = 36 J
+    stats.peak_mA     = _peak_mA;
+    stats.avg_mA      = (uint16_t)((_avgMaQ4 + 8) >> 4);
+    stats.runtime_min = runtimeMin(stats.used_mAh, stats.avg_mA);
   }
 
 private:
-  Servo _rudder;
-
-  static constexpr int SERVO_US_CENTER = 1500;
-  static constexpr int SERVO_US_RANGE  = 400;
+  static constexpr uint32_t FOLD_MS      = 1000;
+  static constexpr uint16_t PACK_MAH     = 5000;   // system pack capacity
+  static constexpr uint16_t IDLE_MA      = 50;     // below this the estimate is meaningless
+  static constexpr uint8_t  AVG_SHIFT    = 5;      // ~32 s EMA at one fold per second
+
+  uint64_t _pI = 0, _pV = 0, _pIV = 0;
+  uint32_t _pN = 0;
+  uint64_t _qMaSamples = 0;
+  uint64_t _eMwSamples = 0;
+  uint16_t _peak_mA = 0;
+  uint32_t _avgMaQ4 = 0;
+  bool     _avgPrimed = false;
+  uint32_t _lastFoldMs = 0;
+
+  void fold(uint16_t zero12) {
+    if (_pN == 0) return;
+
+    const int64_t dI  = (int64_t)_pI - (int64_t)_pN * zero12;
+    const int64_t dIV = (int64_t)_pIV - (int64_t)_pV * zero12;
+    const uint64_t q = dI > 0 ? ((uint64_t)dI * TB_ACS_MA_Q16) >> 16 : 0;              // mA x samples
+    const uint64_t e = dIV > 0 ? ((((uint64_t)dIV * TB_ACS_MA_Q16) >> 16) * TB_VBAT_MV_Q16 >> 16) / 1000u : 0;
+    _qMaSamples += q;
+    _eMwSamples += e;
+
+    const uint32_t meanQ4 = (uint32_t)((q << 4) / _pN);
+    if (!_avgPrimed) {
+      _avgMaQ4 = meanQ4;
+      _avgPrimed = true;
+    } else {
+      _avgMaQ4 = (uint32_t)((int32_t)_avgMaQ4 + (((int32_t)meanQ4 - (int32_t)_avgMaQ4) >> AVG_SHIFT));
+    }
 
-  static int rudderPctToUs(int8_t rudderPct) {
-    const int r = clampi((int)rudderPct, -100, 100);
-    return SERVO_US_CENTER + (r * SERVO_US_RANGE) / 100;
+    _pI = _pV = _pIV = 0;
+    _pN = 0;
   }
 
-  static void drivePropulsion(int8_t throttlePct, bool armed) {
-    if (!armed) {
-      digitalWrite(PIN_BTS_LEN, LOW);
-      digitalWrite(PIN_BTS_REN, LOW);
-      analogWrite(PIN_BTS_LPWM, 0);
-      analogWrite(PIN_BTS_RPWM, 0);
-      return;
-    }
-
-    int t = clampi((int)throttlePct, -100, 100);
+  static uint16_t runtimeMin(uint16_t used_mAh, uint16_t avg_mA) {
+    if (avg_mA < IDLE_MA) return 0xFFFF;
+    const uint32_t left = used_mAh < PACK_MAH ? (uint32_t)(PACK_MAH - used_mAh) : 0;
+    return clamp16(left * 60u / avg_mA);
+  }
 
-    digitalWrite(PIN_BTS_LEN, HIGH);
-    digitalWrite(PIN_BTS_REN, HIGH);
+  static uint16_t clamp16(uint64_t v) { return v > 0xFFFEu ? 0xFFFEu : (uint16_t)v; }
+};
+#endif
 
-    if (t == 0) {
-      analogWrite(PIN_BTS_LPWM, 0);
-      analogWrite(PIN_BTS_RPWM, 0);
-      return;
+// =============================================================================
+// WATER ALARM
+// =============================================================================
+// Evaluated on the unfiltered decimated WATER sample (~100 Hz) rather than the
+// ~1 Hz IIR output. Trips once it has spent TB_WATER_TRIP_MS over the trip
+// level (dips count back down, so sloshing does not restart the debounce) and
+// clears the same way after TB_WATER_CLEAR_MS under the lower clear level. On
+// either edge the queued ACK is rewritten, so the next ACK the TX gets carries
+// the new TB_S_F_WATER bit instead of one that was built before the crossing.
+static constexpr uint16_t TB_WATER_TRIP_RAW  = 300;   // waterRaw (10-bit)
+static constexpr uint16_t TB_WATER_CLEAR_RAW = 220;
+static constexpr uint32_t TB_WATER_TRIP_MS   = 100;
+static constexpr uint32_t TB_WATER_CLEAR_MS  = 3000;
+// The bilge pump output overrides the commanded accessory value even while
+// disarmed or in failsafe, so it is off unless the pump is actually wired:
+// set TB_BILGE_ACC to its accessory channel (1..4) and TB_BILGE_DUTY to the
+// pump's duty; that channel is then no longer usable for anything else.
+static constexpr uint8_t  TB_BILGE_ACC       = 0;     // accessory 1..4 run as bilge pump while wet, 0 = none
+static constexpr uint8_t  TB_BILGE_DUTY      = 255;
+static constexpr uint32_t TB_BILGE_RUNON_MS  = 10000; // pump keeps running after the alarm clears
+
+#if TB_WATER_ALARM
+class WaterAlarm {
+public:
+  // Returns true when the alarm state changed
+  bool update(uint16_t adc12, uint32_t nowMs) {
+    uint32_t dt = nowMs - _lastMs;
+    if (dt > MAX_STEP_MS) dt = MAX_STEP_MS;   // first call, or a stalled loop
+    _lastMs = nowMs;
+
+    if (!_wet) {
+      if (adc12 >= TRIP12) {
+        if (_overMs == 0) _overSinceUs = micros();
+        _overMs += dt ? dt : 1;
+      } else {
+        _overMs = (_overMs > dt) ? _overMs - dt : 0;   // a short dip only backs off
+      }
+      if (_overMs < TB_WATER_TRIP_MS) return false;
+      _wet = true;
+      _seen = true;
+      _trips++;
+      _underMs = 0;
+      return true;
     }
 
-    const uint8_t pwm = (uint8_t)((abs(t) * 255) / 100);
-    if (t > 0) {
-      analogWrite(PIN_BTS_LPWM, pwm);
-      analogWrite(PIN_BTS_RPWM, 0);
+    if (adc12 <= CLEAR12) {
+      _underMs += dt ? dt : 1;
     } else {
-      analogWrite(PIN_BTS_LPWM, 0);
-      analogWrite(PIN_BTS_RPWM, pwm);
+      _underMs = (_underMs > dt) ? _underMs - dt : 0;
     }
+    if (_underMs < TB_WATER_CLEAR_MS) return false;
+    _wet = false;
+    _overMs = 0;
+    _pumpUntilMs = nowMs + TB_BILGE_RUNON_MS;
+    return true;
   }
 
-  static void driveAccessories(const uint8_t acc[4], bool armed) {
-    analogWrite(PIN_PWM_ACC_1, armed ? acc[0] : 0);
-    analogWrite(PIN_PWM_ACC_2, armed ? acc[1] : 0);
-    analogWrite(PIN_PWM_ACC_3, armed ? acc[2] : 0);
-    analogWrite(PIN_PWM_ACC_4, armed ? acc[3] : 0);
+  // Call once the trip is on the queued ACK; the crossing-to-queued time is
+  // shipped on the THERMAL page
+  void noteSignalled(uint32_t nowUs) {
+    const uint32_t ms = (nowUs - _overSinceUs + 500) / 1000;
+    _tripMs = (uint16_t)(ms > 0xFFFF ? 0xFFFF : ms);
   }
 
-  void driveRudder(int8_t rudderPct, bool armed) {
-    const int us = armed ? rudderPctToUs(rudderPct) : SERVO_US_CENTER;
-    _rudder.writeMicroseconds(us);
+  bool wet() const { return _wet; }
+  uint8_t statusFlags() const {
+    return (uint8_t)((_wet ? TB_S_F_WATER : 0) | (_seen ? TB_S_F_WATER_SEEN : 0));
   }
+  uint16_t tripMs() const { return _tripMs; }
+  uint16_t trips() const { return _trips; }
+
+  // Bilge duty for TB_BILGE_ACC: while wet, then for the run-on
+  uint8_t pumpDuty(uint32_t nowMs) const {
+    if (TB_BILGE_ACC == 0 || !_seen) return 0;
+    return (_wet || (int32_t)(_pumpUntilMs - nowMs) > 0) ? TB_BILGE_DUTY : 0;
+  }
+
+private:
+  static constexpr uint16_t TRIP12  = TB_WATER_TRIP_RAW << TB_ADC_EXTRA_BITS;
+  static constexpr uint16_t CLEAR12 = TB_WATER_CLEAR_RAW << TB_ADC_EXTRA_BITS;
+  static constexpr uint32_t MAX_STEP_MS = 20;   // two decimated samples
+
+  bool     _wet = false;
+  bool     _seen = false;
+  uint32_t _lastMs = 0;
+  uint32_t _overMs = 0;        // leaky time over TRIP12 (dips count down)
+  uint32_t _underMs = 0;       // same, under CLEAR12, while wet
+  uint32_t _overSinceUs = 0;   // first sample of this excursion
+  uint32_t _pumpUntilMs = 0;
+  uint16_t _tripMs = 0;
+  uint16_t _trips = 0;
 };
+#endif
 
 // =============================================================================
-// FAILSAFE
+// MOTOR PWM (throttle curve; Timer4 bridge driver with TB_MOTOR_PWM16)
 // =============================================================================
-class Failsafe {
-public:
+// Throttle curve, applied in both PWM modes: |throttle| up to the deadband is
+// off, just past it the duty starts at TB_THR_START_PCT (motor breakaway), and
+// the rest blends linear with cubic by TB_THR_EXPO_PCT for finer low-speed
+// control. Table in PROGMEM (one entry per %), interpolated in Q8 %.
+static constexpr uint8_t  TB_THR_DEADBAND_PCT = 3;
+static constexpr uint8_t  TB_THR_START_PCT    = 6;
+static constexpr uint8_t  TB_THR_EXPO_PCT     = 30;
+static constexpr uint16_t TB_DUTY12_MAX       = 4095;
+
+static constexpr double TbCxThrCurve(double x) {
+  return (1.0 - TB_THR_EXPO_PCT / 100.0) * x + (TB_THR_EXPO_PCT / 100.0) * x * x * x;
+}
+static constexpr uint16_t TbCxThrEntry(uint16_t pct) {
+  return pct <= TB_THR_DEADBAND_PCT ? 0 :
+         (uint16_t)((TB_THR_START_PCT / 100.0 + (1.0 - TB_THR_START_PCT / 100.0) *
+                     TbCxThrCurve((double)(pct - TB_THR_DEADBAND_PCT) / (100 - TB_THR_DEADBAND_PCT))) *
+                    TB_DUTY12_MAX + 0.5);
+}
+
+template <typename S> struct TbThrTable;
+template <uint16_t... I> struct TbThrTable<TbSeq<I...> > {
+  static const uint16_t data[sizeof...(I)];
+};
+template <uint16_t... I>
+const uint16_t TbThrTable<TbSeq<I...> >::data[sizeof...(I)] PROGMEM = { TbCxThrEntry(I)... };
+
+typedef TbThrTable<TbMakeSeq<101>::type> TbThrDutyTable;
+
+// |throttle| in Q8 % (0..100 << 8) -> duty 0..TB_DUTY12_MAX
+static inline uint16_t TbThrottleDuty12(uint16_t pctQ8) {
+  const uint8_t i = (uint8_t)(pctQ8 >> 8);
+  if (i >= 100) return pgm_read_word(&TbThrDutyTable::data[100]);
+  const uint8_t f = (uint8_t)(pctQ8 & 0xFF);
+  const uint16_t a = pgm_read_word(&TbThrDutyTable::data[i]);
+  const uint16_t b = pgm_read_word(&TbThrDutyTable::data[i + 1]);
+  return (uint16_t)(a + (((uint32_t)(b - a) * f + 0x80) >> 8));
+}
+
+#if TB_MOTOR_PWM16
+// Timer / pin plan (Mega 2560):
+//   Timer0  millis()/micros() only, left at Arduino defaults (old RPWM pin 4 driven low)
+//   Timer1  TaskScheduler 1 kHz tick (TB_SCHED)
+//   Timer2  ACC4 pin 10 (OC2A), 8-bit phase-correct ~490 Hz
+//   Timer3  ACC1 pin 2 (OC3B), ACC2 pin 5 (OC3A), 8-bit phase-correct ~490 Hz
+//   Timer4  fast PWM, TOP = ICR4, clk/1: 16 MHz / 800 = 20 kHz
+//             OC4A pin 6 BTS LPWM, OC4C pin 8 BTS RPWM (was pin 4), OC4B pin 7 ACC3
+//   Timer5  Servo library (rudder on pin 3, pulses from its ISR)
+// 800 counts per period (9.6 bits) is the ceiling at 20 kHz from a 16 MHz
+// clock; MotorPwm16 adds TB_MOTOR_DITHER_BITS of first-order dither across
+// successive updates (ACTUATE runs at 200 Hz), which the motor's mechanical
+// time constant averages: 3200 levels, 11.6 bits.
+static constexpr uint32_t TB_MOTOR_PWM_HZ      = 20000;
+static constexpr uint16_t TB_T4_COUNTS         = (uint16_t)(F_CPU / TB_MOTOR_PWM_HZ);   // clocks per period
+static constexpr uint8_t  TB_MOTOR_DITHER_BITS = 2;
+static_assert(F_CPU % TB_MOTOR_PWM_HZ == 0, "Timer4 period must be a whole number of clocks");
+
+class Timer4Pwm {
+public:
+  enum Channel : uint8_t { CH_A, CH_B, CH_C };
+
+  static void begin() {
+    OCR4A = OCR4B = OCR4C = 0;
+    PORTH &= (uint8_t)~(_BV(PH3) | _BV(PH4) | _BV(PH5));
+    TCCR4B = 0;
+    TCCR4A = (uint8_t)_BV(WGM41);                            // mode 14, outputs detached
+    ICR4   = TB_T4_COUNTS - 1;
+    TCCR4B = (uint8_t)(_BV(WGM43) | _BV(WGM42) | _BV(CS40));
+  }
+
+  // counts = high clocks per period, 0..TB_T4_COUNTS. Fast PWM is high for
+  // OCR + 1 clocks, so 0 cannot be reached on the compare unit; the pin is
+  // parked low on the port instead.
+  static void write(uint8_t ch, uint16_t counts) {
+    const uint8_t com = ch == CH_A ? _BV(COM4A1) : ch == CH_B ? _BV(COM4B1) : _BV(COM4C1);
+    if (counts == 0) {
+      TCCR4A &= (uint8_t)~com;
+      PORTH &= (uint8_t)~(ch == CH_A ? _BV(PH3) : ch == CH_B ? _BV(PH4) : _BV(PH5));
+      return;
+    }
+    const uint16_t ocr = (uint16_t)(counts - 1);
+    if (ch == CH_A) OCR4A = ocr;
+    else if (ch == CH_B) OCR4B = ocr;
+    else OCR4C = ocr;
+    TCCR4A |= com;
+  }
+
+  static uint16_t scale8(uint8_t duty) {
+    return (uint16_t)(((uint32_t)duty * TB_T4_COUNTS + 127) / 255);
+  }
+};
+
+class MotorPwm16 {
+public:
+  static constexpr uint16_t LEVELS = TB_T4_COUNTS << TB_MOTOR_DITHER_BITS;
+
+  void begin() {
+    _dir = 0;
+    _counts = 0;
+    _acc = 0;
+  }
+
+  // dir > 0 drives LPWM, < 0 RPWM; the idle side is parked low first
+  void drive(int8_t dir, uint16_t duty12) {
+    const int8_t d = (duty12 == 0 || dir == 0) ? 0 : (dir > 0 ? 1 : -1);
+    if (d != _dir) {
+      if (_dir != 0) Timer4Pwm::write(_dir > 0 ? Timer4Pwm::CH_A : Timer4Pwm::CH_C, 0);
+      _dir = d;
+      _counts = 0;
+      _acc = 0;
+    }
+    if (d == 0) return;
+
+    const uint16_t level = (uint16_t)(((uint32_t)duty12 * LEVELS + TB_DUTY12_MAX / 2) / TB_DUTY12_MAX);
+    uint16_t counts = (uint16_t)(level >> TB_MOTOR_DITHER_BITS);
+    _acc = (uint8_t)(_acc + (level & ((1u << TB_MOTOR_DITHER_BITS) - 1)));
+    if (_acc >= (1u << TB_MOTOR_DITHER_BITS)) {
+      _acc = (uint8_t)(_acc - (1u << TB_MOTOR_DITHER_BITS));
+      counts++;
+    }
+    if (counts == _counts) return;
+    _counts = counts;
+    Timer4Pwm::write(d > 0 ? Timer4Pwm::CH_A : Timer4Pwm::CH_C, counts);
+  }
+
+  void stop() { drive(0, 0); }
+
+private:
+  int8_t   _dir = 0;
+  uint16_t _counts = 0;
+  uint8_t  _acc = 0;
+};
+
+#endif
+
+// =============================================================================
+// ACTUATOR OUTPUTS (direct registers, write-on-change)
+// =============================================================================
+// analogWrite()/digitalWrite() redo the pin -> timer/port lookups and the
+// compare-output setup on every call. Here the canon pins are mapped once and
+// each setter compares with the cached value before touching hardware.
+// Timers 2/3/4 run Arduino's 8-bit phase-correct PWM, where OCR = 0 / 255 is
+// solid low / high, so those pins stay connected to their compare unit.
+// Timer0 is fast PWM (0 still emits a one-tick pulse, 255 a one-tick gap), so
+// RPWM is handed to the port at either end, as analogWrite does.
+static_assert(PIN_BTS_LEN == 23 && PIN_BTS_REN == 25, "BTS enables: PA1 / PA3");
+#if TB_MOTOR_PWM16
+static_assert(PIN_BTS_LPWM == 6 && PIN_BTS_RPWM == 8, "BTS PWM: OC4A / OC4C");
+#else
+static_assert(PIN_BTS_LPWM == 6 && PIN_BTS_RPWM == 4, "BTS PWM: OC4A / OC0B");
+#endif
+static_assert(PIN_PWM_ACC_1 == 2 && PIN_PWM_ACC_2 == 5 && PIN_PWM_ACC_3 == 7 && PIN_PWM_ACC_4 == 10,
+              "ACC PWM: OC3B / OC3A / OC4B / OC2A");
+
+class ActuatorOutputs {
+public:
+  enum Channel : uint8_t { CH_LPWM, CH_RPWM, CH_ACC1, CH_ACC2, CH_ACC3, CH_ACC4, CH_COUNT };
+
+  // Arduino's init() has already set every timer's PWM mode and prescaler
+  void begin() {
+    static const uint8_t pins[] = {
+      PIN_BTS_LEN, PIN_BTS_REN, PIN_BTS_LPWM, PIN_BTS_RPWM,
+      PIN_PWM_ACC_1, PIN_PWM_ACC_2, PIN_PWM_ACC_3, PIN_PWM_ACC_4,
+#if TB_MOTOR_PWM16
+      PIN_BTS_RPWM_OLD   // a bridge still wired to pin 4 sees RPWM low, not a floating input
+#endif
+    };
+    for (uint8_t i = 0; i < sizeof(pins); i++) {
+      digitalWrite(pins[i], LOW);   // also detaches any compare unit
+      pinMode(pins[i], OUTPUT);
+    }
+
+    OCR3A = 0;
+    OCR3B = 0;
+    OCR2A = 0;
+    TCCR3A |= (uint8_t)(_BV(COM3A1) | _BV(COM3B1));
+    TCCR2A |= (uint8_t)_BV(COM2A1);
+#if TB_MOTOR_PWM16
+    Timer4Pwm::begin();   // bridge + ACC3; parked low until written
+#else
+    OCR4A = 0;
+    OCR4B = 0;
+    OCR0B = 0;
+    TCCR4A |= (uint8_t)(_BV(COM4A1) | _BV(COM4B1));
+#endif
+
+    _enable = false;
+    memset(_duty, 0, sizeof(_duty));
+  }
+
+  // BTS7960 LEN + REN together
+  void setEnable(bool on) {
+    if (on == _enable) return;
+    _enable = on;
+    if (on) PORTA |= (uint8_t)(_BV(PA1) | _BV(PA3));
+    else PORTA &= (uint8_t)~(_BV(PA1) | _BV(PA3));
+  }
+
+  void setDuty(uint8_t ch, uint8_t duty) {
+    if (duty == _duty[ch]) return;
+    _duty[ch] = duty;
+    switch (ch) {
+#if TB_MOTOR_PWM16
+      // bridge channels are normally driven by MotorPwm16 at full resolution
+      case CH_LPWM: Timer4Pwm::write(Timer4Pwm::CH_A, Timer4Pwm::scale8(duty)); break;
+      case CH_RPWM: Timer4Pwm::write(Timer4Pwm::CH_C, Timer4Pwm::scale8(duty)); break;
+      case CH_ACC3: Timer4Pwm::write(Timer4Pwm::CH_B, Timer4Pwm::scale8(duty)); break;
+#else
+      case CH_LPWM: OCR4A = duty; break;
+      case CH_RPWM: writeRpwm(duty); break;
+      case CH_ACC3: OCR4B = duty; break;
+#endif
+      case CH_ACC1: OCR3B = duty; break;
+      case CH_ACC2: OCR3A = duty; break;
+      case CH_ACC4: OCR2A = duty; break;
+      default: break;
+    }
+  }
+
+private:
+  bool    _enable = false;
+  uint8_t _duty[CH_COUNT] = {0};
+
+#if !TB_MOTOR_PWM16
+  // OC0B / PG5
+  static void writeRpwm(uint8_t duty) {
+    if (duty == 0 || duty == 255) {
+      TCCR0A &= (uint8_t)~_BV(COM0B1);
+      if (duty) PORTG |= (uint8_t)_BV(PG5);
+      else PORTG &= (uint8_t)~_BV(PG5);
+      return;
+    }
+    OCR0B = duty;
+    TCCR0A |= (uint8_t)_BV(COM0B1);
+  }
+#endif
+};
+
+// =============================================================================
+// ACTUATORS
+// =============================================================================
+class Actuators {
+public:
+  void begin() {
+    _out.begin();
+#if TB_MOTOR_PWM16
+    _motor.begin();
+#endif
+
+    _rudder.attach(PIN_RUDDER_SERVO);
+    _rudder.writeMicroseconds(SERVO_US_CENTER);
+    _rudderUs = SERVO_US_CENTER;
+  }
+
+  // bilgeDuty drives TB_BILGE_ACC even when disarmed or in failsafe
+  void apply(const TbCmdV1& cmd, bool armed, uint8_t bilgeDuty = 0) {
+    apply(cmd, (int16_t)(cmd.throttlePct * 256), (int16_t)(cmd.rudderPct * 256), armed, bilgeDuty);
+  }
+
+  // Throttle / rudder in Q8 % (MotionStage output); accessories from cmd
+  void apply(const TbCmdV1& cmd, int16_t throttleQ8, int16_t rudderQ8, bool armed, uint8_t bilgeDuty) {
+    drivePropulsion(throttleQ8, armed);
+    driveRudder(rudderQ8, armed);
+    driveAccessories(cmd.acc, armed, bilgeDuty);
+  }
+
+#if TB_ACT_BENCH
+  // Cycles per apply(), the previous Arduino-call path vs this one. Disarmed
+  // throughout, so the bridge and ACC1-3 stay off; the changing case toggles
+  // the bilge duty on ACC4 (1 / 255) so every call has one output to write.
+  void benchmark() {
+    static constexpr uint16_t RUNS = 256;
+    TbCmdV1 cmd {};
+    uint32_t us[4];
+
+    uint32_t t0 = micros();
+    for (uint16_t r = 0; r < RUNS; r++) legacyApply(cmd, false, TB_BILGE_ACC ? 1 : 0);
+    us[0] = micros() - t0;
+    t0 = micros();
+    for (uint16_t r = 0; r < RUNS; r++) legacyApply(cmd, false, (r & 1) ? 255 : 1);
+    us[1] = micros() - t0;
+
+    _out.begin();   // analogWrite/digitalWrite above re-owned the pins
+    _rudderUs = -1;
+    t0 = micros();
+    for (uint16_t r = 0; r < RUNS; r++) apply(cmd, false, TB_BILGE_ACC ? 1 : 0);
+    us[2] = micros() - t0;
+    t0 = micros();
+    for (uint16_t r = 0; r < RUNS; r++) apply(cmd, false, (r & 1) ? 255 : 1);
+    us[3] = micros() - t0;
+    apply(cmd, false, 0);
+
+    const float cyc = (float)(F_CPU / 1000000UL) / RUNS;
+    Serial.print(F("ACT cyc/apply: arduino steady="));
+    Serial.print((float)us[0] * cyc, 0);
+    Serial.print(F(" changing="));
+    Serial.print((float)us[1] * cyc, 0);
+    Serial.print(F("  direct steady="));
+    Serial.print((float)us[2] * cyc, 0);
+    Serial.print(F(" changing="));
+    Serial.println((float)us[3] * cyc, 0);
+  }
+#endif
+
+private:
+  ActuatorOutputs _out;
+#if TB_MOTOR_PWM16
+  MotorPwm16      _motor;
+#endif
+  Servo _rudder;
+  int   _rudderUs = SERVO_US_CENTER;
+
+  static constexpr int SERVO_US_CENTER = 1500;
+  static constexpr int SERVO_US_RANGE  = 400;
+
+  static int rudderPctToUs(int8_t rudderPct) {
+    const int r = clampi((int)rudderPct, -100, 100);
+    return SERVO_US_CENTER + (r * SERVO_US_RANGE) / 100;
+  }
+
+  static int rudderQ8ToUs(int16_t rudderQ8) {
+    const int32_t r = clampPctQ8(rudderQ8);
+    return SERVO_US_CENTER + (int)((r * SERVO_US_RANGE) / (100L << 8));
+  }
+
+  void drivePropulsion(int16_t throttleQ8, bool armed) {
+    if (!armed) {
+      _out.setEnable(false);
+#if TB_MOTOR_PWM16
+      _motor.stop();
+#else
+      _out.setDuty(ActuatorOutputs::CH_LPWM, 0);
+      _out.setDuty(ActuatorOutputs::CH_RPWM, 0);
+#endif
+      return;
+    }
+
+    const int16_t t = clampPctQ8(throttleQ8);
+    const uint16_t duty12 = TbThrottleDuty12((uint16_t)(t < 0 ? -t : t));
+
+    _out.setEnable(true);
+#if TB_MOTOR_PWM16
+    _motor.drive(t > 0 ? 1 : (t < 0 ? -1 : 0), duty12);
+#else
+    const uint8_t pwm = (uint8_t)(duty12 >> 4);
+    _out.setDuty(ActuatorOutputs::CH_LPWM, t > 0 ? pwm : 0);
+    _out.setDuty(ActuatorOutputs::CH_RPWM, t < 0 ? pwm : 0);
+#endif
+  }
+
+  void driveAccessories(const uint8_t acc[4], bool armed, uint8_t bilgeDuty) {
+    for (uint8_t i = 0; i < 4; i++) {
+      uint8_t duty = armed ? acc[i] : 0;
+      if (i + 1 == TB_BILGE_ACC && bilgeDuty > duty) duty = bilgeDuty;
+      _out.setDuty((uint8_t)(ActuatorOutputs::CH_ACC1 + i), duty);
+    }
+  }
+
+  // Servo::writeMicroseconds() masks interrupts to update the Timer5 ISR's table
+  void driveRudder(int16_t rudderQ8, bool armed) {
+    const int us = armed ? rudderQ8ToUs(rudderQ8) : SERVO_US_CENTER;
+    if (us == _rudderUs) return;
+    _rudderUs = us;
+    _rudder.writeMicroseconds(us);
+  }
+
+#if TB_ACT_BENCH
+  // Previous implementation, kept only to time against apply()
+  void legacyApply(const TbCmdV1& cmd, bool armed, uint8_t bilgeDuty) {
+    if (!armed) {
+      digitalWrite(PIN_BTS_LEN, LOW);
+      digitalWrite(PIN_BTS_REN, LOW);
+      analogWrite(PIN_BTS_LPWM, 0);
+      analogWrite(PIN_BTS_RPWM, 0);
+    } else {
+      const int t = clampi((int)cmd.throttlePct, -100, 100);
+      const uint8_t pwm = (uint8_t)((abs(t) * 255) / 100);
+      digitalWrite(PIN_BTS_LEN, HIGH);
+      digitalWrite(PIN_BTS_REN, HIGH);
+      analogWrite(PIN_BTS_LPWM, t > 0 ? pwm : 0);
+      analogWrite(PIN_BTS_RPWM, t < 0 ? pwm : 0);
+    }
+    _rudder.writeMicroseconds(armed ? rudderPctToUs(cmd.rudderPct) : SERVO_US_CENTER);
+
+    uint8_t out[4];
+    for (uint8_t i = 0; i < 4; i++) out[i] = armed ? cmd.acc[i] : 0;
+    if (TB_BILGE_ACC != 0 && bilgeDuty > out[TB_BILGE_ACC - 1]) out[TB_BILGE_ACC - 1] = bilgeDuty;
+    analogWrite(PIN_PWM_ACC_1, out[0]);
+    analogWrite(PIN_PWM_ACC_2, out[1]);
+    analogWrite(PIN_PWM_ACC_3, out[2]);
+    analogWrite(PIN_PWM_ACC_4, out[3]);
+  }
+#endif
+};
+
+// =============================================================================
+// FAILSAFE
+// =============================================================================
+static constexpr uint16_t TB_FAILSAFE_MS = 500;
+
+#if TB_SEQ_TRACK
+// =============================================================================
+// SEQUENCE TRACKING (extended seq, duplicates, reorders, loss windows)
+// =============================================================================
+// The 8-bit wire seq wraps every 12.8 s at 20 Hz; it is unwrapped against the
+// newest seen (nearest within ±127) into a 16-bit extended seq. A bitmap
+// covers the newest TB_SEQ_REORDER_WIN seqs:
+//   newer  advances the window; seqs skipped over are missing for now
+//   in the window, bit set    duplicate (auto-ack retransmit after a lost
+//                             ACK, TX resend): dropped before the Failsafe
+//   in the window, bit clear  reorder: counted as received, not applied
+//   older than the window     stale: dropped, counted as a reorder
+// A seq is settled when it leaves the bitmap; every TB_SEQ_REORDER_WIN settled
+// seqs close one loss window, binned by frames lost (counts halved every
+// DECAY_WINDOWS, like LatencyHist). Tracking resyncs, without charging the
+// outage (the Failsafe reports outages), when the TX seq may have moved out of
+// the ±127 unwrap range:
+//   TB_SEQ_RESYNC_MS without a good frame: the TX sends up to 50 Hz and
+//     control frames share the seq, so 128 frames can pass in ~2.5 s
+//   TB_SEQ_RESYNC_STALE stale frames in a row: TX restarted behind the newest
+static constexpr uint8_t  TB_SEQ_REORDER_WIN  = 32;     // bitmap width = loss window
+static constexpr uint16_t TB_SEQ_RESYNC_MS    = 1000;   // <= ~55 frames at 50 Hz + control frames
+static constexpr uint8_t  TB_SEQ_RESYNC_STALE = 3;
+
+enum TbSeqVerdict : uint8_t {
+  TB_SEQ_NEW   = 0,   // newest so far: apply
+  TB_SEQ_LATE  = 1,   // reordered or stale: counted, not applied
+  TB_SEQ_DUP   = 2,   // already seen: dropped
+  TB_SEQ_RESYNC = 3   // tracking restarted at this seq: apply, Failsafe resyncs too
+};
+
+class SeqTracker {
+public:
+  static constexpr uint8_t BUCKETS = 8;
+
+  // Frames that passed CRC, in arrival order
+  TbSeqVerdict note(uint8_t seq, uint32_t nowMs) {
+    if (!_synced || nowMs - _lastMs > TB_SEQ_RESYNC_MS) {
+      resync(seq, nowMs);
+      return TB_SEQ_RESYNC;
+    }
+    _lastMs = nowMs;
+
+    const int8_t d = (int8_t)(seq - (uint8_t)_ext);
+    if (d > 0) {
+      _stale = 0;
+      advance((uint8_t)d);
+      _seen |= 1;
+      return TB_SEQ_NEW;
+    }
+
+    const uint8_t back = (uint8_t)(-d);
+    if (back >= TB_SEQ_REORDER_WIN) {
+      if (++_stale >= TB_SEQ_RESYNC_STALE) {
+        resync(seq, nowMs);
+        return TB_SEQ_RESYNC;
+      }
+    } else {
+      _stale = 0;
+      if (_seen & (1UL << back)) {
+        if (_dups < 0xFFFF) _dups++;
+        return TB_SEQ_DUP;
+      }
+      _seen |= (1UL << back);
+    }
+    if (_reorders < 0xFFFF) _reorders++;
+    return TB_SEQ_LATE;
+  }
+
+  uint16_t extSeq() const { return _ext; }
+
+  void fill(RxStats& s) const {
+    s.seqExt = _ext;
+    s.seqLost = _lost;
+    s.seqDups = _dups;
+    s.seqReorders = _reorders;
+    s.seqLastWinLost = _lastWinLost;
+
+    uint16_t total = 0;
+    for (uint8_t i = 0; i < BUCKETS; i++) total += _count[i];
+    for (uint8_t i = 0; i < BUCKETS; i++) {
+      s.seqLossHist[i] = total ? (uint8_t)(((uint32_t)_count[i] * 100UL) / total) : 0;
+    }
+  }
+
+private:
+  static constexpr uint16_t DECAY_WINDOWS = 256;   // ~7 min at 20 Hz
+
+  bool     _synced = false;
+  uint32_t _lastMs = 0;
+  uint16_t _ext = 0;
+  uint32_t _seen = 0;       // bit k = seq _ext - k received
+  uint8_t  _skip = 0;       // pre-sync bits still to leave the bitmap (not counted)
+  uint8_t  _stale = 0;      // consecutive frames older than the bitmap
+  uint8_t  _winSeqs = 0;    // settled seqs in the open loss window
+  uint8_t  _winLost = 0;
+  uint8_t  _lastWinLost = 0;
+  uint16_t _lost = 0;
+  uint16_t _dups = 0;
+  uint16_t _reorders = 0;
+  uint16_t _count[BUCKETS] = {0};
+  uint16_t _windows = 0;
+
+  void resync(uint8_t seq, uint32_t nowMs) {
+    // Keep the high byte so the extended seq stays monotonic across resyncs
+    _ext = (uint16_t)(((_ext + (_synced ? 0x100 : 0)) & 0xFF00) | seq);
+    _seen = 1;
+    _skip = TB_SEQ_REORDER_WIN - 1;
+    _stale = 0;
+    _winSeqs = 0;
+    _winLost = 0;
+    _lastMs = nowMs;
+    _synced = true;
+  }
+
+  // Moves the newest seq forward by d, settling the seqs that leave the bitmap
+  // (oldest first; beyond the bitmap they were skipped over, so missing)
+  void advance(uint8_t d) {
+    for (uint8_t i = 0; i < d; i++) {
+      const int8_t pos = (int8_t)(TB_SEQ_REORDER_WIN - 1 - i);
+      const bool got = pos >= 0 && (_seen & (1UL << pos));
+      if (_skip) {
+        _skip--;
+        continue;
+      }
+      settle(got);
+    }
+    _seen = (d >= TB_SEQ_REORDER_WIN) ? 0 : (_seen << d);
+    _ext = (uint16_t)(_ext + d);
+  }
+
+  void settle(bool got) {
+    if (!got) {
+      _winLost++;
+      if (_lost < 0xFFFF) _lost++;
+    }
+    if (++_winSeqs < TB_SEQ_REORDER_WIN) return;
+
+    // Buckets: 0, 1, 2, 3-4, 5-8, 9-16, 17-31, 32
+    uint8_t b = 0;
+    if (_winLost >= TB_SEQ_REORDER_WIN) {
+      b = BUCKETS - 1;
+    } else if (_winLost > 0) {
+      b = 1;
+      for (uint8_t edge = 1; _winLost > edge; edge <<= 1) b++;
+    }
+    _count[b]++;
+    if (++_windows >= DECAY_WINDOWS) {
+      for (uint8_t i = 0; i < BUCKETS; i++) _count[i] >>= 1;
+      _windows = DECAY_WINDOWS / 2;
+    }
+    _lastWinLost = _winLost;
+    _winSeqs = 0;
+    _winLost = 0;
+  }
+};
+#endif
+
+// Graded and sequence-aware. Misses are counted in TX send slots, from two
+// sources:
+//   seq gap   a good frame whose seq jumps by d says d - 1 frames were lost;
+//             that run stands until the next in-sequence frame
+//   silence   the TX sends at least every TB_TX_HEARTBEAT_MS, so silence past
+//             that bound (plus TB_FS_JITTER_MS of TX loop slack) is one
+//             missed frame. From then on the TX is retrying its failed send
+//             at its short send interval, so each further cadenceMs() of
+//             silence is one more missed frame.
+// cadenceMs() is the TX's short send interval, measured from the per-frame
+// gaps (gap / seq delta, EMA) while it streams or retries; heartbeat gaps are
+// kept out of it, since the heartbeat is only the ceiling on silence before
+// the first miss, not the rate. One miss rides through, then:
+//   HOLD    TB_FS_HOLD_MISSES     last command held
+//   RAMP    TB_FS_RAMP_MISSES     throttle slews to zero over TB_FS_RAMP_MS
+//   NEUTRAL TB_FS_NEUTRAL_MISSES  disarmed, outputs neutral (silence only: a
+//                                 frame that just arrived shows the link is up)
+// At the 20 ms send interval a dead link reaches HOLD / RAMP / NEUTRAL after
+// ~145 / ~165 / ~185 ms of silence, against the TB_FAILSAFE_MS cliff, which
+// still applies without a command. Any good frame ends HOLD/RAMP once the
+// seq run is back in order (throttle slews back up at the same rate); leaving
+// NEUTRAL takes TB_FS_RECOVER_FRAMES frames in sequence, so a flapping link
+// does not re-arm on every stray frame.
+static constexpr uint8_t  TB_FS_HOLD_MISSES    = 2;
+static constexpr uint8_t  TB_FS_RAMP_MISSES    = 3;
+static constexpr uint8_t  TB_FS_NEUTRAL_MISSES = 4;
+static constexpr uint16_t TB_FS_RAMP_MS        = 100;
+static constexpr uint8_t  TB_FS_RECOVER_FRAMES = 3;
+static constexpr uint8_t  TB_FS_JITTER_MS      = 25;    // TX loop slack on the heartbeat (OLED / WiFi work)
+static constexpr uint8_t  TB_FS_CADENCE_MS     = TB_TX_MIN_INTERVAL_MS;   // initial estimate
+static constexpr uint8_t  TB_FS_CADENCE_MIN_MS = 5;     // per-frame gaps outside [MIN, MAX]
+static constexpr uint8_t  TB_FS_CADENCE_MAX_MS = 75;    // are not fed to the estimate (heartbeats)
+static_assert(TB_FS_CADENCE_MAX_MS < TB_TX_HEARTBEAT_MS, "heartbeat gaps are not the send cadence");
+static_assert(TB_TX_HEARTBEAT_MS + TB_FS_JITTER_MS + (TB_FS_NEUTRAL_MISSES - 1) * TB_FS_CADENCE_MAX_MS < TB_FAILSAFE_MS,
+              "graded NEUTRAL must come before the TB_FAILSAFE_MS cliff");
+
+class Failsafe {
+public:
   void begin(uint32_t failsafeMs) {
     _failsafeMs = failsafeMs;
     memset(&_lastCmd, 0, sizeof(_lastCmd));
-    _lastCmdMs = millis();
+    _lastCmdMs = _lastFrameMs = _lastUpdateMs = millis();
+    _cadenceQ4 = (uint16_t)TB_FS_CADENCE_MS << 4;
+    _haveSeq = false;
+    _inSeq = 0;
+    _lossRun = 0;
+    _stage = TB_FS_NEUTRAL;
+    _scaleQ8 = 0;
+    _depth = TB_FS_OK;
+  }
+
+  // Any frame that passed CRC, in arrival order. After a long outage the TX
+  // seq may have moved any distance, so the next frame simply resyncs, as does
+  // one the SeqTracker has resynced on (TX restart).
+  void noteFrame(uint8_t seq, uint32_t nowMs, bool resync = false) {
+    if (!resync && _haveSeq && nowMs - _lastFrameMs <= _failsafeMs) {
+      const uint8_t d = (uint8_t)(seq - _lastSeq);
+      if ((int8_t)d <= 0) return;   // repeat or older than the newest seen
+      const uint32_t perFrame = (nowMs - _lastFrameMs) / d;
+      if (perFrame >= TB_FS_CADENCE_MIN_MS && perFrame <= TB_FS_CADENCE_MAX_MS) {
+        _cadenceQ4 = (uint16_t)(_cadenceQ4 + (((int16_t)(perFrame << 4) - (int16_t)_cadenceQ4) >> 3));
+      }
+      _inSeq = (d == 1) ? (uint8_t)min<uint16_t>(_inSeq + 1, 255) : 1;
+      _lossRun = (uint8_t)(d - 1);
+    } else {
+      _inSeq = 1;
+      _lossRun = 0;
+    }
+    _haveSeq = true;
+    _lastSeq = seq;
+    _lastFrameMs = nowMs;
   }
 
   void noteCommand(const TbCmdV1& cmd, uint32_t nowMs) {
@@ -399,133 +1758,1018 @@ public:
     _lastCmdMs = nowMs;
   }
 
+  // Advances the stage machine and the throttle ramp; true on a stage change
+  bool update(uint32_t nowMs) {
+    const TbFsStage next = evaluate(nowMs);
+
+    const uint32_t dt = nowMs - _lastUpdateMs;
+    _lastUpdateMs = nowMs;
+    const uint16_t step = (uint16_t)min<uint32_t>((dt * 256UL) / TB_FS_RAMP_MS, 256UL);
+    if (next == TB_FS_NEUTRAL) _scaleQ8 = 0;
+    else if (!TB_FS_GRADED) _scaleQ8 = 256;
+    else if (next == TB_FS_RAMP) _scaleQ8 = (_scaleQ8 > step) ? (uint16_t)(_scaleQ8 - step) : 0;
+    else _scaleQ8 = (uint16_t)min<uint16_t>(_scaleQ8 + step, 256);
+
+    if (next == _stage) return false;
+    if (next > _stage) {
+      if (_stage == TB_FS_OK) _outStartMs = _lastFrameMs;
+      if (_entries[next - 1] < 255) _entries[next - 1]++;
+      if (next > _depth) _depth = next;
+      if (next == TB_FS_NEUTRAL) _inSeq = 0;
+    } else if (next == TB_FS_OK && _depth != TB_FS_OK) {
+      _lastDepth = _depth;
+      _lastOutMs = (uint16_t)min<uint32_t>(nowMs - _outStartMs, 65535UL);
+      _depth = TB_FS_OK;
+    }
+    _stage = next;
+    return true;
+  }
+
+  TbFsStage stage() const { return _stage; }
+
+  // Throttle multiplier, Q8 (256 = as commanded)
+  uint16_t throttleScaleQ8() const { return _scaleQ8; }
+
   TbCmdV1 commandToApply(uint32_t nowMs) const {
+    (void)nowMs;
     TbCmdV1 out = _lastCmd;
-    const bool fresh = (nowMs - _lastCmdMs) <= _failsafeMs;
-    if (!fresh) {
+    if (_stage == TB_FS_NEUTRAL) {
       out.arm = 0;
       out.throttlePct = 0;
       out.rudderPct = 0;
       out.acc[0] = out.acc[1] = out.acc[2] = out.acc[3] = 0;
+    } else {
+      out.throttlePct = (int8_t)(((int16_t)out.throttlePct * (int16_t)_scaleQ8) / 256);
     }
     return out;
   }
 
+  // TX short send interval (streaming / retrying), ms
+  uint8_t cadenceMs() const { return (uint8_t)((_cadenceQ4 + 8) >> 4); }
+
+  void fill(RxStats& s) const {
+    memcpy(s.fsEntries, _entries, sizeof(s.fsEntries));
+    s.fsLastDepth  = _lastDepth;
+    s.fsLastOut_ms = _lastOutMs;
+    s.cadence_ms   = cadenceMs();
+  }
+
+private:
+  uint32_t  _failsafeMs = TB_FAILSAFE_MS;
+  TbCmdV1   _lastCmd {};
+  uint32_t  _lastCmdMs = 0;
+  uint32_t  _lastFrameMs = 0;
+  uint32_t  _lastUpdateMs = 0;
+  uint16_t  _cadenceQ4 = (uint16_t)TB_FS_CADENCE_MS << 4;
+  uint8_t   _lastSeq = 0;
+  bool      _haveSeq = false;
+  uint8_t   _inSeq = 0;         // consecutive frames with seq delta 1
+  uint8_t   _lossRun = 0;       // frames skipped by the newest frame's seq
+  TbFsStage _stage = TB_FS_NEUTRAL;
+  uint16_t  _scaleQ8 = 0;
+
+  TbFsStage _depth = TB_FS_OK;  // deepest stage of the outage in progress
+  uint32_t  _outStartMs = 0;
+  uint8_t   _entries[3] = {0};
+  uint8_t   _lastDepth = TB_FS_OK;
+  uint16_t  _lastOutMs = 0;
+
+  // Frames the TX has sent since the newest one received: none up to the
+  // heartbeat bound, then one per cadence while it retries
+  uint8_t silentMisses(uint32_t nowMs) const {
+    const uint32_t age = nowMs - _lastFrameMs;
+    static constexpr uint32_t BOUND = (uint32_t)TB_TX_HEARTBEAT_MS + TB_FS_JITTER_MS;
+    if (age < BOUND) return 0;
+    return (uint8_t)min<uint32_t>(1 + (age - BOUND) / cadenceMs(), 255UL);
+  }
+
+  TbFsStage evaluate(uint32_t nowMs) const {
+    const bool cmdFresh = _haveSeq && (nowMs - _lastCmdMs) <= _failsafeMs;
+#if TB_FS_GRADED
+    const uint8_t silent = silentMisses(nowMs);
+    const uint8_t m = (uint8_t)min<uint16_t>(silent + _lossRun, 255);
+    if (!cmdFresh || silent >= TB_FS_NEUTRAL_MISSES) return TB_FS_NEUTRAL;
+    if (_stage == TB_FS_NEUTRAL && _inSeq < TB_FS_RECOVER_FRAMES) return TB_FS_NEUTRAL;
+    if (m >= TB_FS_RAMP_MISSES) return TB_FS_RAMP;
+    if (m >= TB_FS_HOLD_MISSES) return TB_FS_HOLD;
+    return TB_FS_OK;
+#else
+    return cmdFresh ? TB_FS_OK : TB_FS_NEUTRAL;
+#endif
+  }
+};
+
+#if TB_MOTION
+// =============================================================================
+// MOTION STAGE (command interpolation + dead-reckoning)
+// =============================================================================
+// Commands land every ~50 ms; the actuators are driven every ACTUATE pass. Each
+// new command starts a ramp from the current output to its value over one
+// expected packet period (EMA of the inter-arrival gaps), so a 20 Hz stream
+// becomes a continuous trajectory at the cost of about half a period of lag.
+// The TX only streams while its command changes and otherwise sends a
+// TB_TX_HEARTBEAT_MS heartbeat, so a frame that is merely late usually means
+// the stick stopped: the output holds the last target until TB_MOTION_HOLD_MS
+// (heartbeat plus jitter) without a frame. Past that frames are really being
+// lost, so it keeps moving at the last ramp's slope (last target - previous
+// target per period) for TB_MOTION_EXTRAP_MS, then fades linearly to neutral
+// over TB_MOTION_FADE_MS. Extrapolation never passes the ±100 % rails or
+// crosses zero (no dead-reckoned reversals). The Failsafe still disarms at
+// TB_FAILSAFE_MS regardless. Q8 % throughout.
+static constexpr uint16_t TB_MOTION_HOLD_MS     = TB_TX_HEARTBEAT_MS + TB_TX_HEARTBEAT_MS / 2;
+static constexpr uint16_t TB_MOTION_EXTRAP_MS   = 60;
+static constexpr uint16_t TB_MOTION_FADE_MS     = 250;
+static constexpr uint8_t  TB_MOTION_PERIOD_MS   = 50;    // initial estimate (TX send rate)
+static constexpr uint8_t  TB_MOTION_PERIOD_MIN  = 10;    // gaps outside [MIN, MAX] are not fed to
+static constexpr uint8_t  TB_MOTION_PERIOD_MAX  = 75;    // the estimate (bursts / heartbeats / dropouts)
+static_assert(TB_MOTION_PERIOD_MAX < TB_TX_HEARTBEAT_MS, "heartbeat gaps are not a ramp period");
+static_assert(TB_MOTION_HOLD_MS + TB_MOTION_EXTRAP_MS + TB_MOTION_FADE_MS <= TB_FAILSAFE_MS,
+              "motion fade must reach neutral before the failsafe trips");
+
+class MotionStage {
+public:
+  enum Axis : uint8_t { AX_THROTTLE, AX_RUDDER, AX_COUNT };
+
+  void begin(uint32_t nowMs) {
+    _cmdMs = nowMs;
+    _periodQ4 = (uint16_t)TB_MOTION_PERIOD_MS << 4;
+    _have = false;
+    memset(_ax, 0, sizeof(_ax));
+  }
+
+  // Disarmed commands target neutral, so re-arming ramps up from zero
+  void noteCommand(const TbCmdV1& cmd, uint32_t nowMs) {
+    const uint32_t gap = nowMs - _cmdMs;
+    if (_have && gap >= TB_MOTION_PERIOD_MIN && gap <= TB_MOTION_PERIOD_MAX) {
+      _periodQ4 = (uint16_t)(_periodQ4 + (((int16_t)(gap << 4) - (int16_t)_periodQ4) >> 2));
+    }
+
+    const int16_t to[AX_COUNT] = {
+      (int16_t)(cmd.arm ? cmd.throttlePct * 256 : 0),
+      (int16_t)(cmd.arm ? cmd.rudderPct * 256 : 0)
+    };
+    for (uint8_t i = 0; i < AX_COUNT; i++) {
+      AxisState& a = _ax[i];
+      a.from = value(a, gap);
+      a.step = _have ? (int32_t)to[i] - a.to : 0;
+      a.to = to[i];
+    }
+    _cmdMs = nowMs;
+    _have = true;
+  }
+
+  int16_t sample(uint8_t axis, uint32_t nowMs) const { return value(_ax[axis], nowMs - _cmdMs); }
+
+  // No frame for longer than the TX heartbeat allows: extrapolating or fading
+  bool coasting(uint32_t nowMs) const { return _have && (nowMs - _cmdMs) > TB_MOTION_HOLD_MS; }
+
+  uint8_t periodMs() const { return (uint8_t)((_periodQ4 + 8) >> 4); }
+
+private:
+  struct AxisState {
+    int16_t from;   // output when the current target arrived
+    int16_t to;     // current target
+    int32_t step;   // to - previous target
+  };
+
+  AxisState _ax[AX_COUNT];
+  uint32_t  _cmdMs = 0;
+  uint16_t  _periodQ4 = (uint16_t)TB_MOTION_PERIOD_MS << 4;
+  bool      _have = false;
+
+  int16_t value(const AxisState& a, uint32_t ageMs) const {
+    const int32_t p = periodMs();
+    if (ageMs < (uint32_t)p) {
+      return (int16_t)(a.from + ((int32_t)(a.to - a.from) * (int32_t)ageMs) / p);
+    }
+
+    if (ageMs <= TB_MOTION_HOLD_MS) return a.to;
+
+    const uint32_t late = ageMs - TB_MOTION_HOLD_MS;
+    const uint32_t ex = min<uint32_t>(late, TB_MOTION_EXTRAP_MS);
+    int32_t v = clampPctQ8(a.to + (a.step * (int32_t)ex) / p);
+    if ((int32_t)a.to * v <= 0) v = 0;   // at or through zero: stop there
+    if (late <= TB_MOTION_EXTRAP_MS) return (int16_t)v;
+
+    const uint32_t f = late - TB_MOTION_EXTRAP_MS;
+    if (f >= TB_MOTION_FADE_MS) return 0;
+    return (int16_t)((v * (int32_t)(TB_MOTION_FADE_MS - f)) / TB_MOTION_FADE_MS);
+  }
+};
+#endif
+
+// =============================================================================
+// FLIGHT RECORDER (SRAM ring, format in TbRecDecoder)
+// =============================================================================
+// Free SRAM between the heap and the stack (avr-libc symbols)
+extern char* __brkval;
+extern char  __heap_start;
+static uint16_t TbFreeSram() {
+  char top;
+  return (uint16_t)(&top - (__brkval ? __brkval : &__heap_start));
+}
+
+#if TB_FLIGHT_REC
+// TB_REC_BYTES of static SRAM, nothing else grows: records are delta-encoded
+// (typically 6..10 bytes at steady state, so ~25 s of history in 2 KB) with a
+// keyframe every KEY_EVERY records, and the oldest keyframe segment is evicted
+// to make room. A trigger keeps recording for POST_RECORDS, then freezes, so
+// the window around the incident survives until resume().
+static constexpr uint16_t TB_REC_BYTES = 2048;
+
+struct TbRecSample {
+  uint16_t v[TB_REC_FIELDS];
+};
+
+class FlightRecorder {
+public:
+  void begin(uint32_t nowMs) {
+    _head = _tail = _used = 0;
+    _dumpStep = DUMP_IDLE;
+    _sinceKey = 0;
+    _forceKey = true;
+    _reason = TB_REC_RUNNING;
+    _pending = TB_REC_RUNNING;
+    _postLeft = 0;
+    _records = 0;
+    _lastMs = nowMs;
+    _tick = nowMs / TB_REC_PERIOD_MS;
+    _crcWinStartTick = _tick;
+    _crcWinStartBad = 0;
+    _crcPrimed = false;
+  }
+
+  bool due(uint32_t nowMs) const { return !frozen() && nowMs - _lastMs >= TB_REC_PERIOD_MS; }
+
+  void record(uint32_t nowMs, const TbRecSample& s) {
+    if (!due(nowMs)) return;
+    const uint32_t tick = nowMs / TB_REC_PERIOD_MS;
+    const uint32_t gap = tick - _tick - 1;   // periods skipped by a stalled loop
+    _lastMs = nowMs;
+    _tick = tick;
+
+    uint8_t buf[MAX_RECORD];
+    const uint8_t n = encode(s, tick, gap, buf);
+    append(buf, n);
+    checkTriggers(s, tick);
+    memcpy(_prev, s.v, sizeof(_prev));
+    _records++;
+
+    if (_pending != TB_REC_RUNNING && _postLeft > 0 && --_postLeft == 0) {
+      _reason = _pending;
+    }
+  }
+
+  // Keep recording for POST_RECORDS, then freeze (first trigger wins)
+  void trigger(TbRecReason why) {
+    if (frozen() || _pending != TB_REC_RUNNING) return;
+    _pending = why;
+    _postLeft = POST_RECORDS;
+  }
+
+  // Stop now (radio pull, manual)
+  void freeze(TbRecReason why) {
+    if (frozen()) return;
+    _reason = why;
+    _pending = why;
+    _postLeft = 0;
+  }
+
+  // Unfreeze and keep the ring; the next record is a keyframe
+  void resume(uint32_t nowMs) {
+    _dumpStep = DUMP_IDLE;   // the ring moves again under the cursor
+    _reason = TB_REC_RUNNING;
+    _pending = TB_REC_RUNNING;
+    _postLeft = 0;
+    _forceKey = true;
+    _crcPrimed = false;
+    _lastMs = nowMs - TB_REC_PERIOD_MS;
+  }
+
+  bool frozen() const { return _reason != TB_REC_RUNNING; }
+  TbRecReason reason() const { return (TbRecReason)_reason; }
+  uint16_t used() const { return _used; }
+  uint32_t records() const { return _records; }
+
+  // Log bytes from the oldest; returns how many were copied
+  uint8_t read(uint16_t offset, uint8_t* out, uint8_t max) const {
+    if (offset >= _used) return 0;
+    uint8_t n = 0;
+    while (n < max && offset < _used) {
+      out[n++] = at(offset++);
+    }
+    return n;
+  }
+
+  // Decoded CSV on the USB serial, one line per dumpNext() so the caller can
+  // pace it to the UART buffer (~60 B per record is ~5 ms at 115200). The
+  // log is frozen first, so the cursor stays valid until resume().
+  void dumpBegin() {
+    freeze(TB_REC_BY_MANUAL);
+    _dumpSrc.pos = 0;
+    _dumpDec.begin();
+    _dumpStep = DUMP_HEADER;
+  }
+
+  bool dumping() const { return _dumpStep != DUMP_IDLE; }
+
+  void dumpNext(Print& out) {
+    switch (_dumpStep) {
+      case DUMP_HEADER:
+        out.print(F("REC reason="));
+        out.print(_reason);
+        out.print(F(" bytes="));
+        out.print(_used);
+        out.print('/');
+        out.print(TB_REC_BYTES);
+        out.print(F(" period_ms="));
+        out.println(TB_REC_PERIOD_MS);
+        _dumpStep = DUMP_COLUMNS;
+        return;
+      case DUMP_COLUMNS:
+        out.println(F("t_ms,thr,rud,flags,vsys_mV,vprop_mV,isys_mA,tmot_cC,tesc_cC,water,rx_ok,rx_bad,loop_max_us"));
+        _dumpStep = DUMP_RECORDS;
+        return;
+      case DUMP_RECORDS:
+        break;
+      default:
+        return;
+    }
+
+    uint32_t tick = 0;
+    uint16_t v[TB_REC_FIELDS];
+    if (!_dumpDec.next(_dumpSrc, tick, v)) {
+      out.println(F("REC end"));
+      _dumpStep = DUMP_IDLE;
+      return;
+    }
+    out.print(tick * TB_REC_PERIOD_MS);
+    for (uint8_t f = 0; f < TB_REC_FIELDS; f++) {
+      out.print(',');
+      if (f == TB_REC_THR || f == TB_REC_RUD || f == TB_REC_TMOTOR || f == TB_REC_TESC) {
+        out.print((int16_t)v[f]);
+      } else {
+        out.print(v[f]);
+      }
+    }
+    out.println();
+  }
+
 private:
-  uint32_t _failsafeMs = 500;
-  TbCmdV1  _lastCmd {};
-  uint32_t _lastCmdMs = 0;
+  static constexpr uint8_t  KEY_EVERY    = 32;
+  static constexpr uint8_t  POST_RECORDS = 50;        // 5 s after the trigger
+  static constexpr uint8_t  MAX_RECORD   = 2 + 5 + TB_REC_FIELDS * 3;
+  static constexpr uint16_t WATER_TRIP   = TB_WATER_TRIP_RAW;
+  static constexpr uint16_t CRC_BURST    = 5;         // rxBad per second
+
+  enum DumpStep : uint8_t { DUMP_IDLE, DUMP_HEADER, DUMP_COLUMNS, DUMP_RECORDS };
+
+  uint8_t  _ring[TB_REC_BYTES];
+  uint16_t _head = 0;        // next write
+  uint16_t _tail = 0;        // oldest byte (always a record start)
+  uint16_t _used = 0;
+  uint16_t _prev[TB_REC_FIELDS] = {0};
+  uint8_t  _sinceKey = 0;
+  bool     _forceKey = true;
+  uint8_t  _reason = TB_REC_RUNNING;
+  uint8_t  _pending = TB_REC_RUNNING;
+  uint8_t  _postLeft = 0;
+  uint32_t _records = 0;
+  uint32_t _lastMs = 0;
+  uint32_t _tick = 0;
+  uint32_t _crcWinStartTick = 0;
+  uint16_t _crcWinStartBad = 0;
+  bool     _crcPrimed = false;
+
+  struct Source {
+    explicit Source(const FlightRecorder& r) : rec(r) {}
+    const FlightRecorder& rec;
+    uint16_t pos = 0;
+    bool get(uint8_t& b) {
+      if (pos >= rec._used) return false;
+      b = rec.at(pos++);
+      return true;
+    }
+  };
+
+  Source       _dumpSrc { *this };
+  TbRecDecoder _dumpDec;
+  uint8_t      _dumpStep = DUMP_IDLE;
+
+  uint8_t at(uint16_t offset) const {
+    uint16_t i = (uint16_t)(_tail + offset);
+    if (i >= TB_REC_BYTES) i = (uint16_t)(i - TB_REC_BYTES);
+    return _ring[i];
+  }
+
+  void checkTriggers(const TbRecSample& s, uint32_t tick) {
+    // Failsafe while the last applied command was armed
+    const bool wasArmed = (_prev[TB_REC_FLAGS] & TB_REC_FLAG_ARM) != 0;
+    if ((s.v[TB_REC_FLAGS] & TB_REC_FLAG_FAILSAFE) && _records > 0 && wasArmed) {
+      trigger(TB_REC_BY_FAILSAFE);
+    }
+    if (s.v[TB_REC_WATER] >= WATER_TRIP) trigger(TB_REC_BY_WATER);
+
+    if (!_crcPrimed || tick - _crcWinStartTick >= 1000 / TB_REC_PERIOD_MS) {
+      _crcPrimed = true;
+      _crcWinStartTick = tick;
+      _crcWinStartBad = s.v[TB_REC_RXBAD];
+    } else if ((uint16_t)(s.v[TB_REC_RXBAD] - _crcWinStartBad) >= CRC_BURST) {
+      trigger(TB_REC_BY_CRC);
+    }
+  }
+
+  static uint8_t putVarint(uint8_t* out, uint32_t v) {
+    uint8_t n = 0;
+    do {
+      uint8_t b = (uint8_t)(v & 0x7F);
+      v >>= 7;
+      if (v) b |= 0x80;
+      out[n++] = b;
+    } while (v);
+    return n;
+  }
+
+  uint8_t encode(const TbRecSample& s, uint32_t tick, uint32_t gap, uint8_t* out) {
+    const bool key = _forceKey || _used == 0 || _sinceKey >= KEY_EVERY;
+    uint16_t h = key ? TB_REC_H_KEY : (gap ? TB_REC_H_GAP : 0);
+    uint8_t n = 2;
+    if (key) n += putVarint(out + n, tick);
+    else if (gap) n += putVarint(out + n, gap);
+
+    for (uint8_t f = 0; f < TB_REC_FIELDS; f++) {
+      const int16_t d = (int16_t)(s.v[f] - (key ? 0 : _prev[f]));
+      if (!key && d == 0) continue;
+      h |= (uint16_t)(1u << f);
+      const uint16_t z = (uint16_t)(((uint16_t)d << 1) ^ (uint16_t)(d >> 15));
+      n += putVarint(out + n, z);
+    }
+    out[0] = (uint8_t)(h & 0xFF);
+    out[1] = (uint8_t)(h >> 8);
+
+    _sinceKey = key ? 1 : (uint8_t)(_sinceKey + 1);
+    _forceKey = false;
+    return n;
+  }
+
+  // Length of the record starting at offset (header walk, no decode)
+  uint8_t recordLen(uint16_t offset) const {
+    const uint16_t h = (uint16_t)(at(offset) | ((uint16_t)at((uint16_t)(offset + 1)) << 8));
+    uint8_t n = 2;
+    uint8_t varints = 0;
+    if (h & (TB_REC_H_KEY | TB_REC_H_GAP)) varints++;
+    for (uint8_t f = 0; f < TB_REC_FIELDS; f++) {
+      if (h & (1u << f)) varints++;
+    }
+    while (varints) {
+      if (!(at((uint16_t)(offset + n++)) & 0x80)) varints--;
+    }
+    return n;
+  }
+
+  // Drops the oldest segment: its keyframe and every delta up to the next keyframe
+  void evictSegment() {
+    uint16_t off = 0;
+    do {
+      off = (uint16_t)(off + recordLen(off));
+    } while (off < _used && !(at((uint16_t)(off + 1)) & (TB_REC_H_KEY >> 8)));
+
+    _tail = (uint16_t)((_tail + off) % TB_REC_BYTES);
+    _used = (uint16_t)(_used - off);
+    if (_used == 0) _forceKey = true;
+  }
+
+  void append(const uint8_t* buf, uint8_t n) {
+    while (_used + n > TB_REC_BYTES) evictSegment();
+    for (uint8_t i = 0; i < n; i++) {
+      _ring[_head] = buf[i];
+      if (++_head >= TB_REC_BYTES) _head = 0;
+    }
+    _used = (uint16_t)(_used + n);
+  }
 };
+#endif
 
 // =============================================================================
 // RX RADIO LINK + ACK BUILDER
 // =============================================================================
+// Paged ACK rotation: link counters every other ACK, slow pages in between
+static const uint8_t kAckSchedule[] = {
+  TB_PAGE_LINK, TB_PAGE_THERMAL, TB_PAGE_LINK, TB_PAGE_SYSTEM, TB_PAGE_LINK, TB_PAGE_RXLAT,
+  TB_PAGE_LINK, TB_PAGE_ENERGY, TB_PAGE_LINK, TB_PAGE_SCHED, TB_PAGE_LINK, TB_PAGE_SEQ
+};
+
 class RxRadioLink {
 public:
   bool begin() {
     if (!radio.begin()) return false;
 
-    radio.setChannel(RF_CHANNEL);
-    radio.setPALevel(RF24_PA_MIN);
-    radio.setDataRate(RF24_250KBPS);
-    radio.setAutoAck(true);
-    radio.enableDynamicPayloads();
-    radio.enableAckPayload();
+#if TB_HOP
+    _hop.begin(millis());
+    radio.setChannel(_hop.channel());
+#else
+    radio.setChannel(RF_CHANNEL);
+#endif
+    applyLevel(TB_LINK_BOOT_LEVEL);
+    radio.setAutoAck(true);
+    radio.enableDynamicPayloads();
+    radio.enableAckPayload();
+
+    radio.openReadingPipe(1, PIPE_ADDR);
+
+    // ACK payloads raise TX_DS on this end; only RX_DR may pull IRQ low
+    radio.maskIRQ(true, true, false);
+    pinMode(PIN_NRF24_IRQ, INPUT_PULLUP);
+    attachInterrupt(digitalPinToInterrupt(PIN_NRF24_IRQ), TbRadioIsr, FALLING);
+
+    radio.startListening();
+    _lastGoodMs = millis();
+    _lastSpiPollMs = _lastGoodMs;
+    return true;
+  }
+
+  // Link adaptation: with no good frame for TB_LINK_LOST_MS, drop to the
+  // fallback level; the TX does the same and searches fallback/boot levels.
+  // With TB_HOP the follower also falls back to scan-and-lock acquisition.
+  void maintain(uint32_t nowMs) {
+#if TB_HOP
+    const bool wasLocked = _hop.locked();
+    if (_hop.tick(nowMs)) radio.setChannel(_hop.channel());
+#if TB_DEBUG_PRINTS
+    if (wasLocked && !_hop.locked()) Serial.println(F("RF hop lost, scanning"));
+#endif
+#endif
+    if (_level == TB_LINK_FALLBACK_LEVEL) return;
+    if (nowMs - _lastGoodMs < TB_LINK_LOST_MS) return;
+    applyLevel(TB_LINK_FALLBACK_LEVEL);
+  }
+
+  uint8_t level() const { return _level; }
+
+  // Polls radio; returns true if a packet was read (good or bad)
+  bool poll(uint8_t& outSeq, TbStatus& outStatus, TbCmdV1& outCmd, bool& outHasCmd) {
+    outHasCmd = false;
+
+    uint32_t irqUs = 0;
+    const bool irq = takeIrq(irqUs);
+#if TB_RADIO_IRQ
+    // No SPI unless the IRQ fired, a frame may be queued behind the last one
+    // (no new edge for it), or the slow safety poll is due.
+    const uint32_t nowMs = millis();
+    if (!irq && !_rxMaybeQueued && nowMs - _lastSpiPollMs < SAFETY_POLL_MS) return false;
+    _lastSpiPollMs = nowMs;
+#endif
+
+    uint8_t pipe = 0;
+    if (!radio.available(&pipe)) {
+      _rxMaybeQueued = false;
+      return false;
+    }
+#if TB_RADIO_IRQ
+    if (!irq && !_rxMaybeQueued && _irqMissed < 255) _irqMissed++;
+#endif
+    // A queued frame raised no edge of its own: it keeps the earlier stamp
+    if (irq) _arrivalUs = irqUs;
+    else if (!_rxMaybeQueued) _arrivalUs = micros();
+    _rxMaybeQueued = true;
+    _lastPipe = (pipe == 0) ? 1 : pipe;
+
+    outStatus = readFrame(outSeq, outCmd, outHasCmd);
+#if TB_HOP
+    // Good or bad, the frame was auto-acked; the next seq picks the slot
+    hopAfterRx(outSeq, outStatus == TB_S_OK);
+#endif
+    return true;
+  }
+
+  void queueAck(uint8_t seqEcho, TbStatus status, const Telemetry& tel, const RxStats& stats) {
+#if TB_PAGED_ACK
+    TbAckPagedHdr h {};
+    h.ver     = TB_VER;
+    h.type    = TB_ACK_PAGED;
+    h.seqEcho = seqEcho;
+    h.status  = (uint8_t)(status | _statusFlags);
+#if TB_FLIGHT_REC
+    if (_recPending) {
+      // Out of rotation; the schedule resumes where it was
+      h.page = TB_PAGE_REC;
+      _recPending = false;
+    } else
+#endif
+    if (_timePending) {
+      h.page = TB_PAGE_TIME;
+      _timePending = false;
+    } else {
+      h.page   = kAckSchedule[_ackSlot];
+      _ackSlot = (uint8_t)((_ackSlot + 1) % sizeof(kAckSchedule));
+    }
+
+    h.vSys_mV  = tel.vSys_mV;
+    h.vProp_mV = tel.vProp_mV;
+    h.iSys_mA  = tel.iSys_mA;
+
+    uint8_t buf[TB_MAX_AIR];
+    memcpy(buf, &h, TB_ACKP_HDR_LEN);
+    uint8_t n = (uint8_t)(TB_ACKP_HDR_LEN + buildAckPage(h.page, tel, stats, buf + TB_ACKP_HDR_LEN));
+
+    const uint16_t crc = TbCrc16Ccitt(buf, n);
+    buf[n++] = (uint8_t)(crc & 0xFF);
+    buf[n++] = (uint8_t)(crc >> 8);
+    memcpy(_ackBuf, buf, n);
+    _ackLen = n;
+    radio.writeAckPayload(_lastPipe, buf, n);
+#else
+    (void)stats;
+    TbAckV2 ack {};
+    ack.ver     = TB_VER;
+    ack.type    = TB_ACK;
+    ack.seqEcho = seqEcho;
+    ack.status  = (uint8_t)(status | _statusFlags);
+    ack.rxOk    = _rxOk;
+    ack.rxBad   = _rxBad;
+
+    ack.vSys_mV  = tel.vSys_mV;
+    ack.vProp_mV = tel.vProp_mV;
+    ack.iSys_mA  = tel.iSys_mA;
+    ack.tMotor_cC = tel.tMotor_cC;
+    ack.tEsc_cC   = tel.tEsc_cC;
+    ack.waterRaw  = tel.waterRaw;
+
+    ack.crc16 = TbAckCrc(ack);
+    memcpy(_ackBuf, &ack, TB_ACK_LEN);
+    _ackLen = TB_ACK_LEN;
+    radio.writeAckPayload(_lastPipe, &ack, TB_ACK_LEN);
+#endif
+  }
+
+  // Alarm flags ORed into every ACK status. A change rewrites the ACK already
+  // in the TX FIFO (status byte + CRC only; same seqEcho and page), so it goes
+  // out on the very next frame instead of one frame later. If a frame has
+  // already taken that ACK (and sits unread in the RX FIFO), writing again
+  // would leave two queued and every later ACK a frame behind, so the flags
+  // then ride on the next queueAck() instead.
+  void setStatusFlags(uint8_t flags) {
+    if (flags == _statusFlags) return;
+    _statusFlags = flags;
+    if (_ackLen == 0) return;
+
+    // status sits at offset 3 in both TbAckV2 and TbAckPagedHdr; CRC is the last 2 bytes
+    _ackBuf[offsetof(TbAckPagedHdr, status)] =
+        (uint8_t)((_ackBuf[offsetof(TbAckPagedHdr, status)] & TB_S_CODE_MASK) | flags);
+    const uint8_t n = (uint8_t)(_ackLen - TB_CRC_LEN);
+    const uint16_t crc = TbCrc16Ccitt(_ackBuf, n);
+    _ackBuf[n]     = (uint8_t)(crc & 0xFF);
+    _ackBuf[n + 1] = (uint8_t)(crc >> 8);
+    if (radio.isFifo(true, true)) return;   // FIFO_STATUS TX_EMPTY: already sent
+    radio.flush_tx();
+    radio.writeAckPayload(_lastPipe, _ackBuf, _ackLen);
+  }
+
+  // TX timestamp token of the frame last returned by poll(), if it carried one
+  bool frameToken(uint32_t& out) const {
+    out = _frameToken;
+    return _frameHasToken;
+  }
+
+  // Echoes a stamped command once applied: out of rotation on the next ACK
+  // (paged ACKs only; the fixed TbAckV2 has no room for it)
+  void echoTime(uint32_t token, uint32_t applyUs) {
+    _timeToken = token;
+    _timeApplyUs = (uint16_t)min<uint32_t>(applyUs, 65535UL);
+    _timePending = true;
+  }
+
+  uint16_t rxOk() const { return _rxOk; }
+  uint16_t rxBad() const { return _rxBad; }
+  static bool irqPending() { return g_rfIrqPending; }
+  uint32_t arrivalUs() const { return _arrivalUs; }   // of the frame last returned by poll()
+
+#if TB_FLIGHT_REC
+  // TB_REC_REQ reads are answered from this log on the next ACK
+  void attachRecorder(FlightRecorder* rec) { _rec = rec; }
+#endif
+
+  void noteCoalesced(uint8_t frames) { _coalesced = (uint16_t)(_coalesced + frames); }
 
-    radio.openReadingPipe(1, PIPE_ADDR);
-    radio.startListening();
-    return true;
+private:
+  uint16_t _rxOk = 0;
+  uint16_t _rxBad = 0;
+  uint16_t _coalesced = 0;
+  uint8_t  _lastPipe = 1;
+  uint8_t  _level = TB_LINK_BOOT_LEVEL;
+  uint32_t _lastGoodMs = 0;
+  uint8_t  _frame[TB_MAX_AIR] = {0}; // radio buffer; TbFrameView parses in place
+  uint8_t  _ackBuf[TB_MAX_AIR] = {0}; // copy of the queued ACK, for setStatusFlags()
+  uint8_t  _ackLen = 0;
+  uint8_t  _statusFlags = 0;
+  uint32_t _frameToken = 0;
+  bool     _frameHasToken = false;
+  uint32_t _timeToken = 0;
+  uint16_t _timeApplyUs = 0;
+  bool     _timePending = false;
+
+  static constexpr uint32_t SAFETY_POLL_MS = 50;
+  uint32_t _arrivalUs = 0;
+  uint32_t _lastSpiPollMs = 0;
+  bool     _rxMaybeQueued = false;
+  uint8_t  _irqMissed = 0;
+
+#if TB_FLIGHT_REC
+  FlightRecorder* _rec = nullptr;
+  bool     _recPending = false;
+  uint16_t _recOffset = 0;
+#endif
+
+  static bool takeIrq(uint32_t& outUs) {
+    noInterrupts();
+    const bool pending = g_rfIrqPending;
+    outUs = g_rfIrqUs;
+    g_rfIrqPending = false;
+    interrupts();
+    return pending;
   }
+#if TB_HOP
+  TbHopFollower _hop;
 
-  // Polls radio; returns true if a packet was read (good or bad)
-  bool poll(TbHdr& outHdr, TbStatus& outStatus, TbCmdV1& outCmd, bool& outHasCmd) {
-    outHasCmd = false;
+  void hopAfterRx(uint8_t seq, bool seqValid) {
+    const bool wasLocked = _hop.locked();
+    _hop.noteRx(seq, seqValid, millis());
+    radio.setChannel(_hop.channel());
+#if TB_DEBUG_PRINTS
+    if (!wasLocked) {
+      Serial.print(F("RF hop locked, next ch "));
+      Serial.println(_hop.channel());
+    }
+#endif
+  }
+#endif
 
-    uint8_t pipe = 0;
-    if (!radio.available(&pipe)) return false;
+  // Compact CMD delta state: acc[] persists between frames, refreshed by frames carrying TB_CMDC_F_ACC.
+  // Until the first frame carrying acc[] after boot, accessories stay at 0.
+  uint8_t  _cmdcAcc[TB_CMDC_ACC_LEN] = {0};
+  bool     _cmdcSynced = false;
 
+  // Reads and validates the pending frame into _frame
+  TbStatus readFrame(uint8_t& outSeq, TbCmdV1& outCmd, bool& outHasCmd) {
     const uint8_t len = radio.getDynamicPayloadSize();
     if (len == 0 || len > TB_MAX_AIR) {
       radio.flush_rx();
-      outStatus = TB_S_BAD_LEN;
+      bool txOk = false, txFail = false, rxReady = false;
+      radio.whatHappened(txOk, txFail, rxReady);   // read() would have cleared RX_DR
 
-      // Use last hdr values as "unknown"
-      memset(&outHdr, 0, sizeof(outHdr));
-      outHdr.seq = 0;
-      _lastPipe = pipe ? pipe : 1;
+      // seq unknown
+      outSeq = 0;
       bumpBadOnce();
-      return true;
+      return TB_S_BAD_LEN;
     }
 
-    uint8_t frame[TB_MAX_AIR] = {0};
-    radio.read(frame, len);
+    radio.read(_frame, len);
+    _frameHasToken = false;
 
-    const uint8_t* payload = nullptr;
-    uint8_t payloadLen = 0;
+    if ((_frame[0] & TB_CMDC_TAG_MASK) == TB_CMDC_TAG) {
+      return decodeCompact(len, outSeq, outCmd, outHasCmd);
+    }
 
-    TbStatus st = TbParseFrame(frame, len, outHdr, payload, payloadLen);
+    TbFrameView fv;
+    TbStatus st = fv.parse(_frame, len);
+    outSeq = fv.hasHdr() ? fv.seq() : 0;
 
     // packet-level counters
     if (st == TB_S_OK) {
       _rxOk++;
+      _lastGoodMs = millis();
     } else {
       bumpBadOnce();
     }
 
+    // TB_HF_TS: the token rides at the end of the payload
+    uint8_t payLen = fv.hasHdr() ? fv.len() : 0;
+    if (st == TB_S_OK && (fv.flags() & TB_HF_TS)) {
+      if (payLen < TB_TS_LEN) {
+        st = TB_S_BAD_LEN;
+        bumpBadMaybe(); // may be no-op if TB_COUNT_BAD_ONCE==1
+      } else {
+        payLen = (uint8_t)(payLen - TB_TS_LEN);
+        _frameToken = TbLoadLe32(fv.payload() + payLen);
+        _frameHasToken = true;
+      }
+    }
+
     // semantic checks
     if (st == TB_S_OK) {
-      if (outHdr.type == TB_CMD) {
-        if (payloadLen != TB_CMD_LEN) {
+      if (fv.type() == TB_CMD) {
+        if (payLen != TB_CMD_LEN) {
           st = TB_S_BAD_LEN;
           bumpBadMaybe(); // may be no-op if TB_COUNT_BAD_ONCE==1
         } else {
-          TbCmdV1 cmd {};
-          memcpy(&cmd, payload, sizeof(cmd));
-          cmd.throttlePct = (int8_t)clampi((int)cmd.throttlePct, -100, 100);
-          cmd.rudderPct   = (int8_t)clampi((int)cmd.rudderPct,   -100, 100);
-          outCmd = cmd;
+          const TbCmdView cv(fv.payload());
+          outCmd.throttlePct = (int8_t)clampi((int)cv.throttlePct(), -100, 100);
+          outCmd.rudderPct   = (int8_t)clampi((int)cv.rudderPct(),   -100, 100);
+          outCmd.acc[0] = cv.acc(0);
+          outCmd.acc[1] = cv.acc(1);
+          outCmd.acc[2] = cv.acc(2);
+          outCmd.acc[3] = cv.acc(3);
+          outCmd.arm    = cv.arm();
           outHasCmd = true;
         }
-      } else if (outHdr.type == TB_PING) {
+      } else if (fv.type() == TB_PING) {
         // OK; telemetry still returned
+      } else if (fv.type() == TB_LINK_CFG) {
+        // The auto-ack for this frame has already gone out at the old
+        // settings, so the switch is safe to make right now.
+        const uint8_t level = fv.payload()[offsetof(TbLinkCfgV1, level)];
+        if (payLen != sizeof(TbLinkCfgV1) || level >= TB_LINK_LEVELS) {
+          st = TB_S_BAD_LEN;
+          bumpBadMaybe(); // may be no-op if TB_COUNT_BAD_ONCE==1
+        } else {
+          applyLevel(level);
+        }
+      } else if (fv.type() == TB_HOP_CFG) {
+        // Taken before the post-read hop so both ends step with the new mask
+        const uint16_t mask = TbLoadLe16(fv.payload() + offsetof(TbHopCfgV1, blacklist));
+        if (payLen != sizeof(TbHopCfgV1) || !TbHopPlan::validMask(mask)) {
+          st = TB_S_BAD_LEN;
+          bumpBadMaybe(); // may be no-op if TB_COUNT_BAD_ONCE==1
+        } else {
+#if TB_HOP
+          _hop.setMask(mask);
+#endif
+        }
+#if TB_FLIGHT_REC
+      } else if (fv.type() == TB_REC_REQ) {
+        const uint8_t op = fv.payload()[offsetof(TbRecReqV1, op)];
+        if (payLen != sizeof(TbRecReqV1) || op > TB_REC_OP_RESUME || _rec == nullptr) {
+          st = TB_S_BAD_LEN;
+          bumpBadMaybe(); // may be no-op if TB_COUNT_BAD_ONCE==1
+        } else if (op == TB_REC_OP_READ) {
+          // Frozen so every chunk of one pull comes from the same log
+          _rec->freeze(TB_REC_BY_PULL);
+          _recOffset = TbLoadLe16(fv.payload() + offsetof(TbRecReqV1, offset));
+          _recPending = true;
+        } else {
+          _rec->resume(millis());
+        }
+#endif
       } else {
         st = TB_S_BAD_TYPE;
         bumpBadMaybe(); // may be no-op if TB_COUNT_BAD_ONCE==1
       }
     }
 
-    outStatus = st;
-    _lastPipe = (pipe == 0) ? 1 : pipe;
-    return true;
+    return st;
   }
 
-  void queueAck(uint8_t seqEcho, TbStatus status, const Telemetry& tel) {
-    TbAckV2 ack {};
-    ack.ver     = TB_VER;
-    ack.type    = TB_ACK;
-    ack.seqEcho = seqEcho;
-    ack.status  = (uint8_t)status;
-    ack.rxOk    = _rxOk;
-    ack.rxBad   = _rxBad;
+  TbStatus decodeCompact(uint8_t len, uint8_t& outSeq, TbCmdV1& outCmd, bool& outHasCmd) {
+    const uint8_t flags = _frame[0];
+    outSeq = (len >= 2) ? _frame[1] : 0;
 
-    ack.vSys_mV  = tel.vSys_mV;
-    ack.vProp_mV = tel.vProp_mV;
-    ack.iSys_mA  = tel.iSys_mA;
-    ack.tMotor_cC = tel.tMotor_cC;
-    ack.tEsc_cC   = tel.tEsc_cC;
-    ack.waterRaw  = tel.waterRaw;
+    const uint8_t accLen = (flags & TB_CMDC_F_ACC) ? TB_CMDC_ACC_LEN : 0;
+    const uint8_t tsLen  = (flags & TB_CMDC_F_TS) ? TB_TS_LEN : 0;
+    const uint8_t noCrc  = (uint8_t)(TB_CMDC_BASE_LEN + accLen + tsLen);
+    if (len != noCrc + TB_CRC_LEN) {
+      bumpBadOnce();
+      return TB_S_BAD_LEN;
+    }
+    if (TbLoadLe16(_frame + noCrc) != TbCrc16Ccitt(_frame, noCrc)) {
+      bumpBadOnce();
+      return TB_S_BAD_CRC;
+    }
+    _rxOk++;
+    _lastGoodMs = millis();
 
-    ack.crc16 = TbAckCrc(ack);
-    radio.writeAckPayload(_lastPipe, &ack, sizeof(ack));
+    if (accLen) {
+      memcpy(_cmdcAcc, _frame + TB_CMDC_BASE_LEN, TB_CMDC_ACC_LEN);
+      _cmdcSynced = true;
+    }
+    if (tsLen) {
+      _frameToken = TbLoadLe32(_frame + TB_CMDC_BASE_LEN + accLen);
+      _frameHasToken = true;
+    }
+
+    outCmd.throttlePct = (int8_t)clampi((int)(int8_t)_frame[2], -100, 100);
+    outCmd.rudderPct   = (int8_t)clampi((int)(int8_t)_frame[3], -100, 100);
+    for (uint8_t i = 0; i < TB_CMDC_ACC_LEN; i++) {
+      outCmd.acc[i] = _cmdcSynced ? _cmdcAcc[i] : 0;
+    }
+    outCmd.arm = (flags & TB_CMDC_F_ARM) ? 1 : 0;
+    outHasCmd = true;
+    return TB_S_OK;
   }
 
-  uint16_t rxOk() const { return _rxOk; }
-  uint16_t rxBad() const { return _rxBad; }
+#if TB_PAGED_ACK
+  uint8_t _ackSlot = 0;
+
+  // Writes the page body at out; returns its length
+  uint8_t buildAckPage(uint8_t page, const Telemetry& tel, const RxStats& stats, uint8_t* out) const {
+    switch (page) {
+      case TB_PAGE_TIME: {
+        TbAckPageTime p {};
+        p.token    = _timeToken;
+        p.apply_us = _timeApplyUs;
+        memcpy(out, &p, sizeof(p));
+        return sizeof(p);
+      }
+      case TB_PAGE_LINK: {
+        TbAckPageLink p {};
+        p.rxOk  = _rxOk;
+        p.rxBad = _rxBad;
+        p.coalesced = _coalesced;
+        memcpy(p.fsEntries, stats.fsEntries, sizeof(p.fsEntries));
+        p.fsLastDepth  = stats.fsLastDepth;
+        p.fsLastOut_ms = stats.fsLastOut_ms;
+        p.cadence_ms   = stats.cadence_ms;
+        memcpy(out, &p, sizeof(p));
+        return sizeof(p);
+      }
+      case TB_PAGE_SEQ: {
+        TbAckPageSeq p {};
+        p.extSeq   = stats.seqExt;
+        p.lost     = stats.seqLost;
+        p.dups     = stats.seqDups;
+        p.reorders = stats.seqReorders;
+        memcpy(p.lossHist, stats.seqLossHist, sizeof(p.lossHist));
+        p.lastWinLost = stats.seqLastWinLost;
+        memcpy(out, &p, sizeof(p));
+        return sizeof(p);
+      }
+      case TB_PAGE_THERMAL: {
+        TbAckPageThermal p {};
+        p.tMotor_cC = tel.tMotor_cC;
+        p.tEsc_cC   = tel.tEsc_cC;
+        p.waterRaw  = tel.waterRaw;
+        p.waterTrip_ms = stats.waterTrip_ms;
+        memcpy(out, &p, sizeof(p));
+        return sizeof(p);
+      }
+      case TB_PAGE_SYSTEM: {
+        TbAckPageSystem p {};
+        p.uptime_s   = stats.uptime_s;
+        p.loopAvg_us = stats.loopAvg_us;
+        p.loopMax_us = stats.loopMax_us;
+        p.telMax_us  = stats.telMax_us;
+        p.adcRate_Hz = stats.adcRate_Hz;
+        p.acsDrift_mA = stats.acsDrift_mA;
+        p.freeSram_B = stats.freeSram_B;
+        memcpy(out, &p, sizeof(p));
+        return sizeof(p);
+      }
+      case TB_PAGE_RXLAT: {
+        TbAckPageRxLat p {};
+        p.avg_us = stats.latAvg_us;
+        p.max_us = stats.latMax_us;
+        memcpy(p.hist, stats.latHist, sizeof(p.hist));
+        p.mode = TB_RADIO_IRQ ? TB_RX_IRQ : TB_RX_POLLED;
+        p.irqMissed = _irqMissed;
+        memcpy(out, &p, sizeof(p));
+        return sizeof(p);
+      }
+#if TB_FLIGHT_REC
+      case TB_PAGE_REC: {
+        TbAckPageRec p {};
+        p.offset = _recOffset;
+        p.total  = _rec->used();
+        p.reason = _rec->reason();
+        p.len    = _rec->read(_recOffset, p.data, sizeof(p.data));
+        memcpy(out, &p, sizeof(p));
+        return sizeof(p);
+      }
+#endif
+      case TB_PAGE_SCHED: {
+        TbAckPageSched p {};
+        memcpy(p.wcet_us, stats.taskWcet_us, sizeof(p.wcet_us));
+        memcpy(p.overruns, stats.taskOverruns, sizeof(p.overruns));
+        memcpy(out, &p, sizeof(p));
+        return sizeof(p);
+      }
+      case TB_PAGE_ENERGY: {
+        TbAckPageEnergy p {};
+        p.used_mAh    = stats.used_mAh;
+        p.used_cWh    = stats.used_cWh;
+        p.peak_mA     = stats.peak_mA;
+        p.avg_mA      = stats.avg_mA;
+        p.runtime_min = stats.runtime_min;
+        memcpy(out, &p, sizeof(p));
+        return sizeof(p);
+      }
+      default:
+        return 0;
+    }
+  }
+#endif
 
-private:
-  uint16_t _rxOk = 0;
-  uint16_t _rxBad = 0;
-  uint8_t  _lastPipe = 1;
+  void applyLevel(uint8_t level) {
+    radio.setDataRate(kTbLinkLevels[level].rate);
+    radio.setPALevel(kTbLinkLevels[level].pa);
+#if TB_DEBUG_PRINTS
+    if (level != _level) {
+      Serial.print(F("RF level "));
+      Serial.print(_level);
+      Serial.print(F(" -> "));
+      Serial.println(level);
+    }
+#endif
+    _level = level;
+  }
 
   // Count bad exactly once per packet when enabled
   void bumpBadOnce() {
@@ -541,6 +2785,211 @@ private:
   }
 };
 
+// =============================================================================
+// LOOP TIMING (loop period average + 1 s window max, for the SYSTEM ACK page)
+// =============================================================================
+class LoopTimer {
+public:
+  void begin(uint32_t nowUs) {
+    _lastUs = nowUs;
+    _avgUs = 0;
+    _winMaxUs = 0;
+    _maxUs = 0;
+    _winStartMs = millis();
+  }
+
+  void mark(uint32_t nowUs) {
+    const uint32_t dt = nowUs - _lastUs;
+    _lastUs = nowUs;
+
+    // EMA, alpha = 1/16
+    _avgUs = _avgUs + (((int32_t)dt - (int32_t)_avgUs) >> 4);
+    if (dt > _winMaxUs) _winMaxUs = dt;
+
+    const uint32_t nowMs = millis();
+    if (nowMs - _winStartMs >= 1000) {
+      _maxUs = _winMaxUs;
+      _winMaxUs = 0;
+      _telMaxUs = _winTelMaxUs;
+      _winTelMaxUs = 0;
+      _winStartMs = nowMs;
+    }
+  }
+
+  // Time spent on telemetry (ADC + conversions) within the current pass
+  void noteTelemetry(uint32_t us) {
+    if (us > _winTelMaxUs) _winTelMaxUs = us;
+  }
+
+  void fill(RxStats& s) const {
+    s.uptime_s   = millis() / 1000UL;
+    s.loopAvg_us = (uint16_t)min<uint32_t>((uint32_t)_avgUs, 65535UL);
+    s.loopMax_us = (uint16_t)min<uint32_t>(_maxUs, 65535UL);
+    s.telMax_us  = (uint16_t)min<uint32_t>(_telMaxUs, 65535UL);
+  }
+
+private:
+  uint32_t _lastUs = 0;
+  int32_t  _avgUs = 0;
+  uint32_t _winMaxUs = 0;
+  uint32_t _maxUs = 0;
+  uint32_t _winTelMaxUs = 0;
+  uint32_t _telMaxUs = 0;
+  uint32_t _winStartMs = 0;
+};
+
+// Radio arrival -> Actuators::apply latency. log2 buckets from 64 us; counts
+// are halved every DECAY_SAMPLES so the shares follow recent behaviour.
+class LatencyHist {
+public:
+  static constexpr uint8_t BUCKETS = 8;
+
+  void add(uint32_t us) {
+    uint8_t b = 0;
+    uint32_t edge = 64;
+    while (b < BUCKETS - 1 && us >= edge) {
+      b++;
+      edge <<= 1;
+    }
+    _count[b]++;
+    if (++_samples >= DECAY_SAMPLES) {
+      for (uint8_t i = 0; i < BUCKETS; i++) _count[i] >>= 1;
+      _samples = DECAY_SAMPLES / 2;
+    }
+
+    // EMA, alpha = 1/16
+    _avgUs = (_avgUs == 0) ? (int32_t)us : _avgUs + (((int32_t)us - _avgUs) >> 4);
+    if (us > _winMaxUs) _winMaxUs = us;
+
+    const uint32_t nowMs = millis();
+    if (nowMs - _winStartMs >= 1000) {
+      _maxUs = _winMaxUs;
+      _winMaxUs = 0;
+      _winStartMs = nowMs;
+    }
+  }
+
+  void fill(RxStats& s) const {
+    s.latAvg_us = (uint16_t)min<uint32_t>((uint32_t)_avgUs, 65535UL);
+    s.latMax_us = (uint16_t)min<uint32_t>(_maxUs, 65535UL);
+
+    uint16_t total = 0;
+    for (uint8_t i = 0; i < BUCKETS; i++) total += _count[i];
+    for (uint8_t i = 0; i < BUCKETS; i++) {
+      s.latHist[i] = total ? (uint8_t)(((uint32_t)_count[i] * 100UL) / total) : 0;
+    }
+  }
+
+private:
+  static constexpr uint16_t DECAY_SAMPLES = 512;
+
+  uint16_t _count[BUCKETS] = {0};
+  uint16_t _samples = 0;
+  int32_t  _avgUs = 0;
+  uint32_t _winMaxUs = 0;
+  uint32_t _maxUs = 0;
+  uint32_t _winStartMs = 0;
+};
+
+#if TB_SCHED
+// =============================================================================
+// TASK SCHEDULER (cooperative, 1 kHz Timer1 tick)
+// =============================================================================
+// Timer1 in CTC mode only counts milliseconds; tasks run from loop() in table
+// order (= priority), at most once per pass, and are never preempted. A task
+// overruns when it finishes more than its deadline after its release; one
+// still due a whole period late is resynced rather than run back to back, and
+// that counts as an overrun too. Servo takes Timer5 on the Mega, so Timer1 is
+// free here.
+enum TbTaskId : uint8_t {
+  TB_TASK_RADIO, TB_TASK_ACTUATE, TB_TASK_FAILSAFE, TB_TASK_SENSE, TB_TASK_TELEM, TB_TASK_HOUSE,
+  TB_TASK_COUNT
+};
+static_assert(TB_TASK_COUNT == TB_SCHED_TASKS, "TbAckPageSched carries one entry per task");
+
+struct TbTaskCfg {
+  uint8_t periodMs;
+  uint8_t deadlineMs;   // after release
+};
+
+static const TbTaskCfg kTbTasks[TB_TASK_COUNT] = {
+  {  2,  2 },   // RADIO     + released by the nRF24 IRQ
+  {  5,  5 },   // ACTUATE   200 Hz + released by a fresh command / failsafe change
+  { 10, 10 },   // FAILSAFE
+  {  5,  5 },   // SENSE     ADC filters, water alarm, energy (decimation is ~100 Hz)
+  {  4,  4 },   // TELEM     one TelemetrySampler slot
+  { 10, 20 },   // HOUSE     link maintenance, flight recorder, USB serial
+};
+
+static volatile uint16_t g_schedTick = 0;
+
+ISR(TIMER1_COMPA_vect) {
+  g_schedTick++;
+}
+
+class TaskScheduler {
+public:
+  void begin() {
+    noInterrupts();
+    TCCR1A = 0;
+    TCCR1B = (uint8_t)(_BV(WGM12) | _BV(CS11) | _BV(CS10));   // CTC, clk/64
+    OCR1A  = (uint16_t)(F_CPU / 64 / 1000 - 1);                // 1 ms
+    TCNT1  = 0;
+    TIMSK1 |= (uint8_t)_BV(OCIE1A);
+    interrupts();
+
+    const uint16_t t = now();
+    for (uint8_t i = 0; i < TB_TASK_COUNT; i++) {
+      _release[i] = t;
+      _wcetUs[i] = 0;
+      _overruns[i] = 0;
+    }
+  }
+
+  static uint16_t now() {
+    noInterrupts();
+    const uint16_t t = g_schedTick;
+    interrupts();
+    return t;
+  }
+
+  bool due(uint8_t id, uint16_t tick) const { return (int16_t)(tick - _release[id]) >= 0; }
+
+  // Sporadic release ahead of the period (event arrived); the period restarts from here
+  void release(uint8_t id, uint16_t tick) {
+    if (!due(id, tick)) _release[id] = tick;
+  }
+
+  void done(uint8_t id, uint32_t startUs) {
+    const uint32_t execUs = micros() - startUs;
+    if (execUs > _wcetUs[id]) _wcetUs[id] = execUs;
+
+    const TbTaskCfg& c = kTbTasks[id];
+    const uint16_t t = now();
+    bool late = (uint16_t)(t - _release[id]) > c.deadlineMs;
+
+    _release[id] = (uint16_t)(_release[id] + c.periodMs);
+    if ((int16_t)(t - _release[id]) >= (int16_t)c.periodMs) {
+      _release[id] = t;
+      late = true;
+    }
+    if (late && _overruns[id] < 255) _overruns[id]++;
+  }
+
+  void fill(RxStats& s) const {
+    for (uint8_t i = 0; i < TB_TASK_COUNT; i++) {
+      s.taskWcet_us[i] = (uint16_t)min<uint32_t>(_wcetUs[i], 65535UL);
+      s.taskOverruns[i] = _overruns[i];
+    }
+  }
+
+private:
+  uint16_t _release[TB_TASK_COUNT] = {0};
+  uint32_t _wcetUs[TB_TASK_COUNT] = {0};
+  uint8_t  _overruns[TB_TASK_COUNT] = {0};
+};
+#endif
+
 // =============================================================================
 // APP (wires everything together)
 // =============================================================================
@@ -555,7 +3004,17 @@ public:
     Serial.println();
     Serial.println(F("TugBot RX — Protocol v2 (iSys_mA) — OOP"));
 
+#if TB_CRC_BENCH
+    TbCrcBenchmark();
+#endif
+#if TB_CONV_BENCH
+    TbConvBenchmark();
+#endif
+
     _act.begin();
+#if TB_ACT_BENCH
+    _act.benchmark();
+#endif
     _tel.begin();
 
     if (!_link.begin()) {
@@ -563,47 +3022,406 @@ public:
       while (1) {}
     }
 
-    _failsafe.begin(500);
+    _failsafe.begin(TB_FAILSAFE_MS);
+#if TB_MOTION
+    _motion.begin(millis());
+#endif
+
+    _loop.begin(micros());
+#if TB_SCHED
+    _sched.begin();
+#endif
+#if TB_ENERGY
+    _energy.begin(millis());
+#endif
+#if TB_FLIGHT_REC
+    _rec.begin(millis());
+    _link.attachRecorder(&_rec);
+    Serial.print(F("REC: "));
+    Serial.print(sizeof(FlightRecorder));
+    Serial.print(F(" B static ("));
+    Serial.print(TB_REC_BYTES);
+    Serial.print(F(" B ring), free SRAM "));
+    Serial.print(TbFreeSram());
+    Serial.println(F(" B. Serial: d=dump r=resume f=freeze s=status"));
+#endif
 
     // Initial ACK payload present (optional but handy)
+    _link.setStatusFlags(statusFlags());   // failsafe starts out NEUTRAL
     const Telemetry t = _tel.read();
-    _link.queueAck(0, TB_S_OK, t);
+    RxStats stats;
+    fillStats(stats);
+    _link.queueAck(0, TB_S_OK, t, stats);
 
     Serial.println(F("Listening..."));
   }
 
   void tick() {
+    _loop.mark(micros());
+
+#if TB_SCHED
+    const uint16_t nowTick = TaskScheduler::now();
+#if TB_RADIO_IRQ
+    if (RxRadioLink::irqPending()) _sched.release(TB_TASK_RADIO, nowTick);
+#endif
+    for (uint8_t id = 0; id < TB_TASK_COUNT; id++) {
+      if (!_sched.due(id, nowTick)) continue;
+      const uint32_t startUs = micros();
+      runTask(id, nowTick, millis());
+      _sched.done(id, startUs);
+    }
+#else
     const uint32_t now = millis();
+    sense(now);
+    sampleTelemetry(now);
+
+#if TB_RADIO_IRQ
+    // A fresh command is applied in the same pass it arrives
+    serviceRadio(now);
+    evaluateFailsafe(now);
+    applyOutputs(now);
+#else
+    evaluateFailsafe(now);
+    applyOutputs(now);
+    serviceRadio(now);
+#endif
 
-    // Failsafe apply
-    const TbCmdV1 cmdToApply = _failsafe.commandToApply(now);
-    const bool armed = (cmdToApply.arm != 0);
-    _act.apply(cmdToApply, armed);
+    housekeeping(now);
+#endif
+  }
 
-    // Receive one packet max per loop
-    TbHdr hdr {};
-    TbStatus st = TB_S_OK;
-    TbCmdV1 cmd {};
-    bool hasCmd = false;
+private:
+    TelemetrySampler _tel;
+    Actuators        _act;
+    Failsafe         _failsafe;
+#if TB_MOTION
+    MotionStage      _motion;
+#endif
+    RxRadioLink      _link;
+    LoopTimer        _loop;
+    LatencyHist      _lat;
+#if TB_SEQ_TRACK
+    SeqTracker       _seq;
+#endif
+#if TB_ENERGY
+    EnergyMeter      _energy;
+#endif
+#if TB_FLIGHT_REC
+    FlightRecorder   _rec;
+#endif
+#if TB_WATER_ALARM
+    WaterAlarm       _water;
+#endif
 
-    if (!_link.poll(hdr, st, cmd, hasCmd)) {
-      return;
+#if TB_SCHED
+    TaskScheduler    _sched;
+#endif
+
+    TbCmdV1  _cmd {};            // what the actuators hold (failsafe applied)
+    bool     _latPending = false;
+    uint32_t _latArrivalUs = 0;
+    bool     _latHasToken = false;   // pending command was stamped by the TX
+    uint32_t _latToken = 0;
+    uint16_t _freeSram = 0;
+
+#if TB_SCHED
+  void runTask(uint8_t id, uint16_t nowTick, uint32_t now) {
+    switch (id) {
+      case TB_TASK_RADIO:
+        // A fresh command is applied in the same pass it arrives
+        if (serviceRadio(now)) {
+          evaluateFailsafe(now);
+          _sched.release(TB_TASK_ACTUATE, nowTick);
+        }
+        break;
+      case TB_TASK_ACTUATE:
+        applyOutputs(now);
+        break;
+      case TB_TASK_FAILSAFE:
+        if (evaluateFailsafe(now)) _sched.release(TB_TASK_ACTUATE, nowTick);
+        break;
+      case TB_TASK_SENSE:
+        sense(now);
+        break;
+      case TB_TASK_TELEM:
+        sampleTelemetry(now);
+        break;
+      case TB_TASK_HOUSE:
+        housekeeping(now);
+        break;
+      default:
+        break;
+    }
+  }
+#endif
+
+  void sense(uint32_t now) {
+#if TB_ADC_ISR
+    g_adcEngine.tick(now);
+#endif
+#if TB_WATER_ALARM
+    serviceWater(now);
+#endif
+#if TB_ENERGY
+    _energy.tick(now, _tel.acsZero12());
+#else
+    (void)now;
+#endif
+  }
+
+  void sampleTelemetry(uint32_t now) {
+#if TB_TEL_BACKGROUND
+    const uint32_t telStartUs = micros();
+    _tel.tick(now);
+    _loop.noteTelemetry(micros() - telStartUs);
+#else
+    (void)now;
+#endif
+  }
+
+  void housekeeping(uint32_t now) {
+    _link.maintain(now);
+#if TB_FLIGHT_REC
+    recordFlight(now);
+    pollSerial(now);
+#endif
+  }
+
+  // Latches the command the actuators hold; true when it changed
+  bool evaluateFailsafe(uint32_t now) {
+    if (_failsafe.update(now)) reportFailsafe();
+    const TbCmdV1 cmd = _failsafe.commandToApply(now);
+    const bool changed = memcmp(&cmd, &_cmd, sizeof(cmd)) != 0;
+    _cmd = cmd;
+    return changed;
+  }
+
+  void applyOutputs(uint32_t now) {
+    const bool armed = (_cmd.arm != 0);
+#if TB_WATER_ALARM
+    const uint8_t bilge = _water.pumpDuty(now);
+#else
+    const uint8_t bilge = 0;
+#endif
+#if TB_MOTION
+    const int32_t thr = ((int32_t)_motion.sample(MotionStage::AX_THROTTLE, now) * _failsafe.throttleScaleQ8()) / 256;
+    _act.apply(_cmd, (int16_t)thr, _motion.sample(MotionStage::AX_RUDDER, now), armed, bilge);
+#else
+    _act.apply(_cmd, armed, bilge);
+#endif
+    _tel.noteArmed(armed, now);
+
+    if (_latPending) {
+      const uint32_t latUs = micros() - _latArrivalUs;
+      _lat.add(latUs);
+      if (_latHasToken) _link.echoTime(_latToken, latUs);
+      _latPending = false;
     }
+  }
+
+  // Drains the RX FIFO (3 deep, plus anything landing meanwhile, capped):
+  // every frame updates the link counters, only the newest valid CMD by seq
+  // reaches the Failsafe (duplicates and late frames never do, TB_SEQ_TRACK),
+  // and one ACK reflects the state after the pass.
+  // Returns true when a command reached the Failsafe.
+  bool serviceRadio(uint32_t now) {
+    static constexpr uint8_t DRAIN_MAX = TB_RX_DRAIN ? 6 : 1;
+
+    uint8_t  frames = 0;
+    uint8_t  ackSeq = 0;
+    TbStatus ackSt = TB_S_OK;
+    bool     haveCmd = false;
+    uint8_t  cmdSeq = 0;
+    TbCmdV1  newest {};
+    uint32_t newestArrivalUs = 0;
+    uint32_t newestToken = 0;
+    bool     newestHasToken = false;
+
+    while (frames < DRAIN_MAX) {
+      uint8_t seq = 0;
+      TbStatus st = TB_S_OK;
+      TbCmdV1 cmd {};
+      bool hasCmd = false;
+      if (!_link.poll(seq, st, cmd, hasCmd)) break;
+
+      frames++;
+      ackSeq = seq;
+      ackSt = st;
+      bool fresh = (st == TB_S_OK);
+#if TB_SEQ_TRACK
+      // Duplicates never reach the Failsafe; late frames show the link is up
+      // but carry an older command than the one already applied
+      const TbSeqVerdict verdict = fresh ? _seq.note(seq, now) : TB_SEQ_NEW;
+      if (verdict == TB_SEQ_DUP) fresh = false;
+      if (verdict == TB_SEQ_LATE) hasCmd = false;
+      if (fresh) _failsafe.noteFrame(seq, now, verdict == TB_SEQ_RESYNC);
+#else
+      if (fresh) _failsafe.noteFrame(seq, now);
+#endif
+      if (fresh && hasCmd && (!haveCmd || (int8_t)(seq - cmdSeq) > 0)) {
+        haveCmd = true;
+        cmdSeq = seq;
+        newest = cmd;
+        newestArrivalUs = _link.arrivalUs();
+        newestHasToken = _link.frameToken(newestToken);
+      }
+    }
+    if (frames == 0) return false;
+    if (frames > 1) _link.noteCoalesced((uint8_t)(frames - 1));
 
-    if (st == TB_S_OK && hasCmd) {
-      _failsafe.noteCommand(cmd, now);
+    if (haveCmd) {
+      _failsafe.noteCommand(newest, now);
+#if TB_MOTION
+      _motion.noteCommand(newest, now);
+#endif
+      _latPending = true;
+      _latArrivalUs = newestArrivalUs;
+      _latHasToken = newestHasToken;
+      _latToken = newestToken;
     }
 
     // Always queue telemetry ACK (good or bad)
+#if TB_TEL_BACKGROUND
+    const Telemetry& t = _tel.snapshot();
+#else
+    const uint32_t telStartUs = micros();
     const Telemetry t = _tel.read();
-    _link.queueAck(hdr.seq, st, t);
+    _loop.noteTelemetry(micros() - telStartUs);
+#endif
+    _freeSram = TbFreeSram();   // sampled once per ACK
+    RxStats stats;
+    fillStats(stats);
+    _link.queueAck(ackSeq, ackSt, t, stats);
+    return haveCmd;
   }
 
-private:
-    TelemetrySampler _tel;
-    Actuators        _act;
-    Failsafe         _failsafe;
-    RxRadioLink      _link;
+  // High bits of every ACK status byte
+  uint8_t statusFlags() const {
+    uint8_t f = (uint8_t)(_failsafe.stage() << TB_S_FS_SHIFT);
+#if TB_WATER_ALARM
+    f |= _water.statusFlags();
+#endif
+    return f;
+  }
+
+  // Stage changes patch the ACK already queued, like the water alarm
+  void reportFailsafe() {
+    _link.setStatusFlags(statusFlags());
+#if TB_DEBUG_PRINTS
+    static const char* const kNames[] = { "OK", "HOLD", "RAMP", "NEUTRAL" };
+    Serial.print(F("FAILSAFE "));
+    Serial.print(kNames[_failsafe.stage()]);
+    Serial.print(F(" cadence_ms="));
+    Serial.println(_failsafe.cadenceMs());
+#endif
+  }
+
+#if TB_WATER_ALARM
+  // Edges patch the ACK already queued (RxRadioLink::setStatusFlags)
+  void serviceWater(uint32_t now) {
+    if (!_water.update(g_adcEngine.raw(TB_ADC_WATER), now)) return;
+    _link.setStatusFlags(statusFlags());
+    if (_water.wet()) {
+      _water.noteSignalled(micros());
+#if TB_FLIGHT_REC
+      _rec.trigger(TB_REC_BY_WATER);
+#endif
+    }
+#if TB_DEBUG_PRINTS
+    if (_water.wet()) {
+      Serial.print(F("WATER ALARM raw="));
+      Serial.print(g_adcEngine.raw(TB_ADC_WATER) >> TB_ADC_EXTRA_BITS);
+      Serial.print(F(" trip_ms="));
+      Serial.println(_water.tripMs());
+    } else {
+      Serial.println(F("WATER clear"));
+    }
+#endif
+  }
+#endif
+
+#if TB_FLIGHT_REC
+  void recordFlight(uint32_t now) {
+    if (!_rec.due(now)) return;
+
+    const TbCmdV1 cmd = _failsafe.commandToApply(now);
+#if TB_TEL_BACKGROUND
+    const Telemetry& t = _tel.snapshot();
+#else
+    const Telemetry t = _tel.read();
+#endif
+    RxStats stats;
+    _loop.fill(stats);
+
+    TbRecSample s;
+    s.v[TB_REC_THR]     = (uint16_t)(int16_t)cmd.throttlePct;
+    s.v[TB_REC_RUD]     = (uint16_t)(int16_t)cmd.rudderPct;
+    s.v[TB_REC_FLAGS]   = (uint16_t)((cmd.arm ? TB_REC_FLAG_ARM : 0) |
+                                     (_failsafe.stage() == TB_FS_NEUTRAL ? TB_REC_FLAG_FAILSAFE : 0) |
+                                     (_failsafe.stage() << TB_REC_FLAG_FS_SHIFT));
+    s.v[TB_REC_VSYS]    = t.vSys_mV;
+    s.v[TB_REC_VPROP]   = t.vProp_mV;
+    s.v[TB_REC_ISYS]    = t.iSys_mA;
+    s.v[TB_REC_TMOTOR]  = (uint16_t)t.tMotor_cC;
+    s.v[TB_REC_TESC]    = (uint16_t)t.tEsc_cC;
+    s.v[TB_REC_WATER]   = t.waterRaw;
+    s.v[TB_REC_RXOK]    = _link.rxOk();
+    s.v[TB_REC_RXBAD]   = _link.rxBad();
+    s.v[TB_REC_LOOPMAX] = stats.loopMax_us;
+    _rec.record(now, s);
+  }
+
+  // USB serial: d = dump (decoded CSV), r = resume, f = freeze, s = status.
+  // The dump goes out one line per HOUSE pass, only into an empty UART
+  // buffer, so printing never stalls the scheduler.
+  void pollSerial(uint32_t now) {
+    if (_rec.dumping()) {
+      if (Serial.availableForWrite() >= SERIAL_TX_BUFFER_SIZE - 1) _rec.dumpNext(Serial);
+      return;
+    }
+    if (!Serial.available()) return;
+    switch (Serial.read()) {
+      case 'd': _rec.dumpBegin(); break;
+      case 'r': _rec.resume(now); Serial.println(F("REC resumed")); break;
+      case 'f': _rec.freeze(TB_REC_BY_MANUAL); Serial.println(F("REC frozen")); break;
+      case 's':
+        Serial.print(F("REC reason="));
+        Serial.print(_rec.reason());
+        Serial.print(F(" bytes="));
+        Serial.print(_rec.used());
+        Serial.print(F(" records="));
+        Serial.print(_rec.records());
+        Serial.print(F(" free_sram="));
+        Serial.println(TbFreeSram());
+        break;
+      default:
+        break;
+    }
+  }
+#endif
+
+  void fillStats(RxStats& stats) const {
+    _loop.fill(stats);
+    _lat.fill(stats);
+#if TB_ADC_ISR
+    stats.adcRate_Hz = g_adcEngine.minRateHz();
+#endif
+    stats.acsDrift_mA = _tel.acsDriftMilliAmps();
+    stats.freeSram_B = _freeSram;
+    _failsafe.fill(stats);
+#if TB_SEQ_TRACK
+    _seq.fill(stats);
+#endif
+#if TB_WATER_ALARM
+    stats.waterTrip_ms = _water.tripMs();
+#endif
+#if TB_ENERGY
+    _energy.fill(stats);
+#endif
+#if TB_SCHED
+    _sched.fill(stats);
+#endif
+  }
 };
 
 // =============================================================================
@@ -0,0 +1,1013 @@
+/*
+  TugBot protocol v2 — shared by the RX (Mega2560) and TX (ESP32) sketches
+  -----------------------------------------------------------------------------
+  Everything both ends must agree on: frame/ACK layouts, page structs, link and
+  hop tables, the hop leader/follower pair, CRC16, the little-endian field
+  helpers and the zero-copy frame/ACK views over them. Header-only; the sketch picks the CRC backend by defining
+  TB_CRC_BACKEND before including it.
+*/
+#pragma once
+
+#include <Arduino.h>
+#include <RF24.h>
+#include <string.h>
+
+#ifndef TB_CRC_BACKEND
+#define TB_CRC_BACKEND 1
+#endif
+
+// =============================================================================
+// PROTOCOL v2
+// =============================================================================
+
+static constexpr uint8_t TB_MAX_AIR = 32;
+static constexpr uint8_t TB_VER     = 2;
+
+// TX send timing (event-driven): changes go out at most every MIN_INTERVAL,
+// an idle link still carries a frame every HEARTBEAT, and a failed send is
+// retried after MIN_INTERVAL. The RX allows up to HEARTBEAT of silence, then
+// counts one missed frame per MIN_INTERVAL (measured) of further silence.
+static constexpr uint8_t TB_TX_MIN_INTERVAL_MS = 20;
+static constexpr uint8_t TB_TX_HEARTBEAT_MS    = 100;
+
+enum TbMsgType : uint8_t {
+  TB_CMD  = 1,
+  TB_PING = 2,
+  TB_ACK  = 4,
+  TB_ACK_PAGED = 8,
+  TB_LINK_CFG = 16,
+  TB_HOP_CFG  = 32,
+  TB_REC_REQ  = 64
+};
+
+enum TbStatus : uint8_t {
+  TB_S_OK       = 0,
+  TB_S_BAD_VER  = 1,
+  TB_S_BAD_LEN  = 2,
+  TB_S_BAD_CRC  = 3,
+  TB_S_BAD_TYPE = 4
+};
+
+// ACK status byte: low nibble TbStatus for the echoed frame, high bits are
+// RX alarm flags carried on every ACK regardless of the page
+static constexpr uint8_t TB_S_CODE_MASK    = 0x0F;
+static constexpr uint8_t TB_S_FS_MASK      = 0x30;  // RX failsafe stage (TbFsStage << TB_S_FS_SHIFT)
+static constexpr uint8_t TB_S_FS_SHIFT     = 4;
+static constexpr uint8_t TB_S_F_WATER_SEEN = 0x40;  // water alarm tripped since RX boot
+static constexpr uint8_t TB_S_F_WATER      = 0x80;  // water alarm active (debounced, hysteresis)
+
+enum TbFsStage : uint8_t {
+  TB_FS_OK      = 0,   // commands applied as received
+  TB_FS_HOLD    = 1,   // expected frames missed: last command held
+  TB_FS_RAMP    = 2,   // throttle ramping to zero, rudder + accessories held
+  TB_FS_NEUTRAL = 3    // disarmed, all outputs neutral
+};
+
+enum TbAckPage : uint8_t {
+  TB_PAGE_LINK    = 0,
+  TB_PAGE_THERMAL = 1,
+  TB_PAGE_SYSTEM  = 2,
+  TB_PAGE_RXLAT   = 3,
+  TB_PAGE_ENERGY  = 4,
+  TB_PAGE_REC     = 5,   // only in reply to TB_REC_REQ
+  TB_PAGE_SCHED   = 6,
+  TB_PAGE_TIME    = 7,   // echo of a stamped frame, queued once it has been applied
+  TB_PAGE_SEQ     = 8,
+  TB_PAGE_COUNT
+};
+
+enum TbRxMode : uint8_t {
+  TB_RX_POLLED  = 0,
+  TB_RX_IRQ     = 1
+};
+
+// TbHdr.flags
+static constexpr uint8_t TB_HF_TS  = 0x01;  // last TB_TS_LEN payload bytes: TX micros() token (TB_PAGE_TIME)
+static constexpr uint8_t TB_TS_LEN = 4;
+
+#pragma pack(push, 1)
+struct TbHdr {
+  uint8_t ver;
+  uint8_t type;
+  uint8_t flags;
+  uint8_t seq;
+  uint8_t len;   // payload length (token included with TB_HF_TS)
+};
+
+struct TbCmdV1 {
+  int8_t  throttlePct;   // -100..100
+  int8_t  rudderPct;     // -100..100
+  uint8_t acc[4];        // 0..255
+  uint8_t arm;           // 0/1
+};
+
+struct TbAckV2 {
+  uint8_t  ver;
+  uint8_t  type;     // TB_ACK
+  uint8_t  seqEcho;
+  uint8_t  status;
+  uint16_t rxOk;
+  uint16_t rxBad;
+
+  uint16_t vSys_mV;
+  uint16_t vProp_mV;
+
+  uint16_t iSys_mA;  // system current
+
+  int16_t  tMotor_cC;
+  int16_t  tEsc_cC;
+  uint16_t waterRaw;
+
+  uint16_t crc16;
+};
+
+// Paged ACK (TB_ACK_PAGED): common header + fast block on every ACK, then one
+// rotating page body, then crc16 LE over everything before it. Lets slow fields
+// share the 32-byte ACK payload without growing it.
+struct TbAckPagedHdr {
+  uint8_t  ver;
+  uint8_t  type;     // TB_ACK_PAGED
+  uint8_t  seqEcho;
+  uint8_t  status;
+  uint8_t  page;     // TbAckPage
+
+  uint16_t vSys_mV;  // fast block (every ACK)
+  uint16_t vProp_mV;
+  uint16_t iSys_mA;
+};
+
+struct TbAckPageLink {
+  uint16_t rxOk;
+  uint16_t rxBad;
+  uint16_t coalesced;     // frames drained and superseded in the same RX pass
+  uint8_t  fsEntries[3];  // entries into HOLD / RAMP / NEUTRAL since RX boot (saturating)
+  uint8_t  fsLastDepth;   // deepest TbFsStage of the last outage (TB_FS_OK = none yet)
+  uint16_t fsLastOut_ms;  // last outage: last good frame -> back to TB_FS_OK
+  uint8_t  cadence_ms;    // measured TX frame period
+};
+
+struct TbAckPageThermal {
+  int16_t  tMotor_cC;
+  int16_t  tEsc_cC;
+  uint16_t waterRaw;
+  uint16_t waterTrip_ms;  // last alarm: first sample over trip -> ACK re-queued with TB_S_F_WATER
+};
+
+struct TbAckPageSystem {
+  uint32_t uptime_s;
+  uint16_t loopAvg_us;
+  uint16_t loopMax_us;
+  uint16_t telMax_us;  // longest telemetry work in one loop pass (last 1 s window)
+  uint16_t adcRate_Hz; // slowest telemetry ADC channel, achieved samples/s (0 = analogRead)
+  int16_t  acsDrift_mA; // ACS712 zero tracked since RX boot (0 = tracking off)
+  uint16_t freeSram_B;  // heap top to stack, sampled in loop()
+};
+
+// RX radio-arrival -> Actuators::apply latency
+struct TbAckPageRxLat {
+  uint16_t avg_us;
+  uint16_t max_us;     // last 1 s window
+  uint8_t  hist[8];    // % of recent samples per bucket: <64, <128 .. <4096, >=4096 us
+  uint8_t  mode;       // TbRxMode
+  uint8_t  irqMissed;  // frames found by the safety poll without an IRQ (saturating)
+};
+
+// System-pack energy since RX boot, integrated at the ADC decimation rate
+struct TbAckPageEnergy {
+  uint16_t used_mAh;
+  uint16_t used_cWh;     // Wh x 100
+  uint16_t peak_mA;      // highest ~10 ms mean current
+  uint16_t avg_mA;       // smoothed (~30 s) discharge current
+  uint16_t runtime_min;  // remaining at avg_mA, 0xFFFF = unknown (near idle)
+};
+
+// Echo of a stamped frame (TB_HF_TS / TB_CMDC_F_TS). The TX pairs the token
+// with its own RTT for that frame to estimate command -> actuator delay.
+struct TbAckPageTime {
+  uint32_t token;     // as stamped by the TX
+  uint16_t apply_us;  // RX radio arrival -> Actuators::apply for that command
+};
+
+static constexpr uint8_t TB_SEQ_LOSS_WIN = 32;   // frames per loss window (RX TB_SEQ_REORDER_WIN)
+
+// Sequence accounting on the RX's extended (16-bit, unwrapped) seq. Loss is
+// final once a frame falls out of the 32-frame reorder window (all zero with
+// TB_SEQ_TRACK off).
+struct TbAckPageSeq {
+  uint16_t extSeq;       // newest extended seq seen
+  uint16_t lost;         // frames never received (saturating)
+  uint16_t dups;         // repeats dropped before the Failsafe
+  uint16_t reorders;     // late frames (counted as received, not applied)
+  uint8_t  lossHist[8];  // % of recent 32-frame windows by frames lost: 0, 1, 2, 3-4, 5-8, 9-16, 17-31, 32
+  uint8_t  lastWinLost;  // frames lost in the last complete window
+};
+
+// RX task scheduler health, one entry per task: RADIO, ACTUATE, FAILSAFE,
+// SENSE, TELEM, HOUSE (all zero with the RX scheduler off)
+static constexpr uint8_t TB_SCHED_TASKS = 6;
+struct TbAckPageSched {
+  uint16_t wcet_us[TB_SCHED_TASKS];   // longest single run since RX boot
+  uint8_t  overruns[TB_SCHED_TASKS];  // deadline misses + dropped releases (saturating)
+};
+
+// One chunk of the frozen flight recorder log (see TbRecDecoder)
+struct TbAckPageRec {
+  uint16_t offset;     // of data[0] from the oldest byte
+  uint16_t total;      // log bytes
+  uint8_t  reason;     // TbRecReason
+  uint8_t  len;        // valid bytes in data
+  uint8_t  data[13];
+};
+
+// TB_REC_REQ payload
+struct TbRecReqV1 {
+  uint8_t  op;         // TbRecOp
+  uint16_t offset;     // TB_REC_OP_READ: first byte wanted
+};
+#pragma pack(pop)
+
+// Wire-format guard. Both sketches compile these structs and the views below
+// from this one header; the asserts pin the on-air layout, so a field that
+// moves fails the build on both ends.
+static_assert(sizeof(TbHdr)   == 5,  "TbHdr wire layout");
+static_assert(sizeof(TbCmdV1) == 7,  "TbCmdV1 wire layout");
+static_assert(sizeof(TbAckV2) == 22, "TbAckV2 wire layout");
+static_assert(offsetof(TbHdr, type) == 1 && offsetof(TbHdr, seq) == 3 && offsetof(TbHdr, len) == 4,
+              "TbHdr wire layout");
+static_assert(offsetof(TbCmdV1, acc) == 2 && offsetof(TbCmdV1, arm) == 6, "TbCmdV1 wire layout");
+static_assert(offsetof(TbAckV2, rxOk) == 4 && offsetof(TbAckV2, vSys_mV) == 8 &&
+              offsetof(TbAckV2, iSys_mA) == 12 && offsetof(TbAckV2, waterRaw) == 18 &&
+              offsetof(TbAckV2, crc16) == 20, "TbAckV2 wire layout");
+static_assert(sizeof(TbAckPagedHdr) == 11, "TbAckPagedHdr wire layout");
+static_assert(offsetof(TbAckPagedHdr, page) == 4 && offsetof(TbAckPagedHdr, vSys_mV) == 5,
+              "TbAckPagedHdr wire layout");
+static_assert(sizeof(TbAckPageLink) == 13 && sizeof(TbAckPageThermal) == 8 &&
+              sizeof(TbAckPageSystem) == 16 && sizeof(TbAckPageRxLat) == 14, "TbAckPage* wire layout");
+static_assert(offsetof(TbAckPageRxLat, hist) == 4 && offsetof(TbAckPageRxLat, mode) == 12,
+              "TbAckPageRxLat wire layout");
+static_assert(offsetof(TbAckPageLink, fsEntries) == 6 && offsetof(TbAckPageLink, fsLastOut_ms) == 10,
+              "TbAckPageLink wire layout");
+static_assert(sizeof(TbAckPageEnergy) == 10 && offsetof(TbAckPageEnergy, runtime_min) == 8,
+              "TbAckPageEnergy wire layout");
+static_assert(sizeof(TbAckPageRec) == 19 && offsetof(TbAckPageRec, data) == 6, "TbAckPageRec wire layout");
+static_assert(sizeof(TbRecReqV1) == 3, "TbRecReqV1 wire layout");
+static_assert(sizeof(TbAckPageSched) == 18 && offsetof(TbAckPageSched, overruns) == 12,
+              "TbAckPageSched wire layout");
+static_assert(sizeof(TbAckPageTime) == 6 && offsetof(TbAckPageTime, apply_us) == 4, "TbAckPageTime wire layout");
+static_assert(sizeof(TbAckPageSeq) == 17 && offsetof(TbAckPageSeq, lossHist) == 8, "TbAckPageSeq wire layout");
+
+static constexpr uint8_t TB_HDR_LEN = sizeof(TbHdr);
+static constexpr uint8_t TB_CRC_LEN = 2;
+static constexpr uint8_t TB_MAX_PAY = (uint8_t)(TB_MAX_AIR - TB_HDR_LEN - TB_CRC_LEN);
+static constexpr uint8_t TB_CMD_LEN = sizeof(TbCmdV1);
+static constexpr uint8_t TB_ACK_LEN = sizeof(TbAckV2);
+static constexpr uint8_t TB_ACKP_HDR_LEN  = sizeof(TbAckPagedHdr);
+static constexpr uint8_t TB_ACKP_MAX_BODY = (uint8_t)(TB_MAX_AIR - TB_ACKP_HDR_LEN - TB_CRC_LEN);
+static_assert(sizeof(TbAckPageLink) <= TB_ACKP_MAX_BODY &&
+              sizeof(TbAckPageThermal) <= TB_ACKP_MAX_BODY && sizeof(TbAckPageSystem) <= TB_ACKP_MAX_BODY &&
+              sizeof(TbAckPageRxLat) <= TB_ACKP_MAX_BODY && sizeof(TbAckPageEnergy) <= TB_ACKP_MAX_BODY &&
+              sizeof(TbAckPageRec) <= TB_ACKP_MAX_BODY && sizeof(TbAckPageSched) <= TB_ACKP_MAX_BODY &&
+              sizeof(TbAckPageTime) <= TB_ACKP_MAX_BODY && sizeof(TbAckPageSeq) <= TB_ACKP_MAX_BODY,
+              "ACK page body exceeds the 32-byte ACK payload");
+
+static inline uint8_t TbAckPageLen(uint8_t page) {
+  switch (page) {
+    case TB_PAGE_LINK:    return sizeof(TbAckPageLink);
+    case TB_PAGE_THERMAL: return sizeof(TbAckPageThermal);
+    case TB_PAGE_SYSTEM:  return sizeof(TbAckPageSystem);
+    case TB_PAGE_RXLAT:   return sizeof(TbAckPageRxLat);
+    case TB_PAGE_ENERGY:  return sizeof(TbAckPageEnergy);
+    case TB_PAGE_REC:     return sizeof(TbAckPageRec);
+    case TB_PAGE_SCHED:   return sizeof(TbAckPageSched);
+    case TB_PAGE_TIME:    return sizeof(TbAckPageTime);
+    case TB_PAGE_SEQ:     return sizeof(TbAckPageSeq);
+    default:              return 0;
+  }
+}
+
+// Flight recorder stream (RX SRAM ring; dumped on the RX USB serial or pulled
+// with TB_REC_REQ into TB_PAGE_REC chunks). One record per TB_REC_PERIOD_MS:
+//   u16 LE header: bits 0..11 = fields present, TB_REC_H_GAP, TB_REC_H_KEY
+//   keyframe: varint tick (absolute, in periods); gap: varint ticks skipped
+//   then per present field, in bit order: zigzag varint of (value - previous)
+//   mod 2^16. Varints are 7 bits per byte, low group first, 0x80 = more.
+// A keyframe carries every field against 0, so a reader can start at any
+// keyframe; the RX evicts whole keyframe segments when the ring is full.
+static constexpr uint32_t TB_REC_PERIOD_MS = 100;
+static constexpr uint16_t TB_REC_H_KEY     = 0x8000;
+static constexpr uint16_t TB_REC_H_GAP     = 0x4000;
+static constexpr uint8_t  TB_REC_FLAG_ARM      = 0x01;  // command being applied is armed
+static constexpr uint8_t  TB_REC_FLAG_FAILSAFE = 0x02;  // failsafe neutral (outputs forced safe)
+static constexpr uint8_t  TB_REC_FLAG_FS_SHIFT = 2;     // bits 2-3: TbFsStage
+
+enum TbRecField : uint8_t {
+  TB_REC_THR, TB_REC_RUD, TB_REC_FLAGS,
+  TB_REC_VSYS, TB_REC_VPROP, TB_REC_ISYS,
+  TB_REC_TMOTOR, TB_REC_TESC, TB_REC_WATER,
+  TB_REC_RXOK, TB_REC_RXBAD, TB_REC_LOOPMAX,
+  TB_REC_FIELDS
+};
+
+// Why the recorder stopped (TB_REC_RUNNING = still recording)
+enum TbRecReason : uint8_t {
+  TB_REC_RUNNING     = 0,
+  TB_REC_BY_FAILSAFE = 1,  // command went stale while armed
+  TB_REC_BY_CRC      = 2,  // rxBad burst
+  TB_REC_BY_WATER    = 3,  // waterRaw over threshold
+  TB_REC_BY_PULL     = 4,  // frozen for a TB_REC_REQ read
+  TB_REC_BY_MANUAL   = 5
+};
+
+enum TbRecOp : uint8_t { TB_REC_OP_READ = 0, TB_REC_OP_RESUME = 1 };
+
+// Reads records from any byte source with bool get(uint8_t&). Records before
+// the first keyframe are skipped; values are kept as uint16 (signed fields cast back).
+class TbRecDecoder {
+public:
+  void begin() {
+    _synced = false;
+    _tick = 0;
+    memset(_v, 0, sizeof(_v));
+  }
+
+  // false at end of stream (or a truncated record)
+  template <typename Src>
+  bool next(Src& src, uint32_t& outTick, uint16_t outV[TB_REC_FIELDS]) {
+    for (;;) {
+      uint8_t lo = 0, hi = 0;
+      if (!src.get(lo) || !src.get(hi)) return false;
+      const uint16_t h = (uint16_t)(lo | ((uint16_t)hi << 8));
+
+      uint32_t t = 0;
+      if ((h & (TB_REC_H_KEY | TB_REC_H_GAP)) && !varint(src, t)) return false;
+
+      const bool use = _synced || (h & TB_REC_H_KEY);
+      if (h & TB_REC_H_KEY) {
+        _tick = t;
+        memset(_v, 0, sizeof(_v));
+        _synced = true;
+      } else if (use) {
+        _tick += 1 + t;
+      }
+
+      for (uint8_t f = 0; f < TB_REC_FIELDS; f++) {
+        if (!(h & (1u << f))) continue;
+        uint32_t z = 0;
+        if (!varint(src, z)) return false;
+        const int16_t d = (int16_t)((z >> 1) ^ (0u - (z & 1u)));
+        _v[f] = (uint16_t)(_v[f] + d);
+      }
+
+      if (!use) continue;
+      outTick = _tick;
+      memcpy(outV, _v, sizeof(_v));
+      return true;
+    }
+  }
+
+private:
+  bool     _synced = false;
+  uint32_t _tick = 0;
+  uint16_t _v[TB_REC_FIELDS] = {0};
+
+  template <typename Src>
+  static bool varint(Src& src, uint32_t& out) {
+    out = 0;
+    for (uint8_t shift = 0; shift < 35; shift += 7) {
+      uint8_t b = 0;
+      if (!src.get(b)) return false;
+      out |= (uint32_t)(b & 0x7F) << shift;
+      if (!(b & 0x80)) return true;
+    }
+    return false;
+  }
+};
+
+// Compact delta CMD frame (TB_CMDC). No TbHdr: byte 0 carries a tag in the high
+// nibble (a v2 frame always starts with TB_VER) plus flags, so it is 6 bytes on
+// the air instead of 14 unless acc[] changed or a keyframe is due. A keyframe
+// is just a frame with ACC set; bit 2 of byte 0 is reserved and sent as 0.
+// Throttle and rudder stay one int8 each: 201 x 201 values need 16 bits anyway.
+//   [0]    TB_CMDC_TAG | TS | 0 | ACC | ARM
+//   [1]    seq
+//   [2]    throttlePct (int8)
+//   [3]    rudderPct   (int8)
+//   [4..7] acc[4]      only when ACC is set
+//   [..+4] token       only when TS is set (TX micros(), echoed on TB_PAGE_TIME)
+//   [n..]  crc16 LE over all preceding bytes
+static constexpr uint8_t TB_CMDC_TAG      = 0xD0;
+static constexpr uint8_t TB_CMDC_TAG_MASK = 0xF0;
+static constexpr uint8_t TB_CMDC_F_TS     = 0x08;
+static constexpr uint8_t TB_CMDC_F_ACC    = 0x02;
+static constexpr uint8_t TB_CMDC_F_ARM    = 0x01;
+static constexpr uint8_t TB_CMDC_BASE_LEN = 4;
+static constexpr uint8_t TB_CMDC_ACC_LEN  = 4;
+
+// Link adaptation ladder (TB_LINK_CFG). Ordered by decreasing link budget
+// (RX sensitivity + PA step); both ends must hold the identical table.
+struct TbLinkLevel {
+  rf24_datarate_e rate;
+  uint8_t         pa;
+};
+
+static const TbLinkLevel kTbLinkLevels[] = {
+  { RF24_250KBPS, RF24_PA_MAX  },  // 0  most robust (loss fallback)
+  { RF24_250KBPS, RF24_PA_HIGH },  // 1
+  { RF24_250KBPS, RF24_PA_LOW  },  // 2
+  { RF24_250KBPS, RF24_PA_MIN  },  // 3  boot (previous fixed setting)
+  { RF24_1MBPS,   RF24_PA_LOW  },  // 4
+  { RF24_2MBPS,   RF24_PA_LOW  },  // 5
+  { RF24_2MBPS,   RF24_PA_MIN  },  // 6  quiet bench: lowest latency + power
+};
+static constexpr uint8_t  TB_LINK_LEVELS         = 7;
+static constexpr uint8_t  TB_LINK_BOOT_LEVEL     = 3;
+static constexpr uint8_t  TB_LINK_FALLBACK_LEVEL = 0;
+static constexpr uint32_t TB_LINK_LOST_MS        = 300; // no traffic -> RX drops to fallback
+static_assert(sizeof(kTbLinkLevels) / sizeof(kTbLinkLevels[0]) == TB_LINK_LEVELS, "link ladder size");
+
+// TB_LINK_CFG payload: switch to this ladder level once the frame is acked
+struct TbLinkCfgV1 {
+  uint8_t level;
+};
+
+// Frequency hopping (TB_HOP). Both ends derive the same TB_HOP_LEN-slot channel
+// sequence from TB_HOP_SEED, and a frame goes out on the slot of its own seq
+// (TbHopPlan::slotForSeq): the RX listens on the slot of the seq after the last
+// one it read, so a lost ACK leaves both ends on the same slot. With no frame
+// for TB_HOP_COAST_MS the RX also steps one seq, so a jammed slot cannot hold
+// the link until it is declared lost. The blacklist is negotiated with
+// TB_HOP_CFG and dropped on both ends when the link is lost.
+static constexpr uint16_t TB_HOP_SEED          = 0x7B1D;
+static constexpr uint8_t  TB_HOP_LEN           = 13;
+static constexpr uint8_t  TB_HOP_CH_MIN        = 2;    // 2402 MHz
+static constexpr uint8_t  TB_HOP_CH_MAX        = 80;   // 2480 MHz (inside the ISM band)
+static constexpr uint8_t  TB_HOP_CH_SPACING    = 3;    // clear of the 2 Mbps channel width
+static constexpr uint8_t  TB_HOP_MIN_ACTIVE    = 6;
+static constexpr uint32_t TB_HOP_COAST_MS      = 150;  // > TX heartbeat; see below
+static constexpr uint32_t TB_HOP_SCAN_DWELL_MS = 2500; // RX park time per slot while acquiring
+static_assert(TB_HOP_LEN <= 16, "hop blacklist is a 16-bit slot mask");
+
+// TB_HOP_CFG payload: bit n set = skip slot n
+struct TbHopCfgV1 {
+  uint16_t blacklist;
+};
+static_assert(sizeof(TbHopCfgV1) == 2, "TbHopCfgV1 wire layout");
+
+class TbHopPlan {
+public:
+  // xorshift16 draws; a channel too close to an earlier pick is redrawn
+  void begin(uint16_t seed) {
+    uint16_t x = seed ? seed : 1;
+    uint8_t n = 0;
+    while (n < TB_HOP_LEN) {
+      x ^= (uint16_t)(x << 7);
+      x ^= (uint16_t)(x >> 9);
+      x ^= (uint16_t)(x << 8);
+      const uint8_t ch = (uint8_t)(TB_HOP_CH_MIN + x % (TB_HOP_CH_MAX - TB_HOP_CH_MIN + 1));
+
+      bool clash = false;
+      for (uint8_t i = 0; i < n; i++) {
+        const uint8_t d = (ch > _ch[i]) ? (uint8_t)(ch - _ch[i]) : (uint8_t)(_ch[i] - ch);
+        if (d < TB_HOP_CH_SPACING) {
+          clash = true;
+          break;
+        }
+      }
+      if (!clash) _ch[n++] = ch;
+    }
+    _mask = 0;
+  }
+
+  uint8_t channel(uint8_t slot) const { return _ch[slot]; }
+  uint16_t mask() const { return _mask; }
+  void setMask(uint16_t mask) { _mask = mask; }
+  bool active(uint8_t slot) const { return (_mask & (1u << slot)) == 0; }
+
+  uint8_t activeCount() const {
+    uint8_t n = 0;
+    for (uint8_t s = 0; s < TB_HOP_LEN; s++) {
+      if (active(s)) n++;
+    }
+    return n;
+  }
+
+  // First active slot after slot (slot itself may be blacklisted)
+  uint8_t next(uint8_t slot) const {
+    for (uint8_t i = 1; i <= TB_HOP_LEN; i++) {
+      const uint8_t s = (uint8_t)((slot + i) % TB_HOP_LEN);
+      if (active(s)) return s;
+    }
+    return slot;
+  }
+
+  // Slot the frame with this (on-air) seq uses. Seqs walk all slots in order
+  // and a blacklisted slot hands its frames to the next active one, so a mask
+  // the two ends disagree on moves only those frames.
+  uint8_t slotForSeq(uint8_t seq) const {
+    const uint8_t s = (uint8_t)(seq % TB_HOP_LEN);
+    return active(s) ? s : next(s);
+  }
+
+  static bool validMask(uint16_t mask) {
+    if (mask >> TB_HOP_LEN) return false;
+    uint8_t blocked = 0;
+    for (uint8_t s = 0; s < TB_HOP_LEN; s++) {
+      if (mask & (1u << s)) blocked++;
+    }
+    return (uint8_t)(TB_HOP_LEN - blocked) >= TB_HOP_MIN_ACTIVE;
+  }
+
+private:
+  uint8_t  _ch[TB_HOP_LEN] = {0};
+  uint16_t _mask = 0;
+};
+
+// =============================================================================
+// FREQUENCY HOPPING (TX leader, RX follower)
+// =============================================================================
+// TbHopLeader (TX): sends frame seq on slotForSeq(seq), so a lost ACK costs
+// nothing: the RX took the frame and waits on the next seq's slot, which is
+// where the next frame goes anyway. After a failed send the TX cannot tell
+// which frames got through, so retries alternate between two guesses:
+//   odd    the RX took failed frame n and its ACK was lost; n walks the
+//          failures since the last ACK, oldest first (up to ALTS of them),
+//          so the first retry goes to its own slot
+//   even   the RX got none since the last ACK and waits on the seq after it
+// Each guess is stepped once per TB_HOP_COAST_MS since that frame, as the RX
+// coasts. After TB_LINK_LOST_MS without an ACK (and from boot) it drops the
+// blacklist and sends on each frame's own slot, so the seq walk sweeps every
+// slot while the RX parks on one.
+//
+// Loss per slot (EMA over in-sync attempts only) drives the adaptive blacklist:
+// every EVAL_MS the worst slot above BL_LOSS_Q8 is proposed for BL_HOLD_MS and
+// expired entries are proposed back in, one TB_HOP_CFG at a time.
+class TbHopLeader {
+public:
+  void begin(uint32_t nowMs) {
+    _plan.begin(TB_HOP_SEED);
+    _slot = 0;
+    _lastAckSeq = 0;
+    _alts = 0;
+    _fails = 0;
+    _ackLostProbe = false;
+    _searching = true;   // nothing acked yet
+    _hasStaged = false;
+    _lastOkMs = nowMs;
+    _lastEvalMs = nowMs;
+    resetSlotStats();
+  }
+
+  // Channel for frame seq (on-air byte)
+  uint8_t pick(uint8_t seq, uint32_t nowMs) {
+    const uint32_t quiet = nowMs - _lastOkMs;
+    if (!_searching && quiet >= TB_LINK_LOST_MS) {
+      _searching = true;
+      _plan.setMask(0);
+      resetSlotStats();
+    }
+
+    _ackLostProbe = false;
+    if (_searching || _fails == 0) {
+      _slot = _plan.slotForSeq(seq);
+    } else if (_fails & 1) {
+      // ACK lost: the RX took one of the failed frames, oldest first (the
+      // first guess is this frame's own slot)
+      _ackLostProbe = true;
+      const uint8_t i = (uint8_t)((_fails / 2) % _alts);
+      _slot = _plan.slotForSeq((uint8_t)(_altSeq[i] + (nowMs - _altMs[i]) / TB_HOP_COAST_MS));
+    } else {
+      // Frames lost: the RX still waits on the seq after the last ACK
+      _slot = _plan.slotForSeq((uint8_t)(_lastAckSeq + 1 + quiet / TB_HOP_COAST_MS));
+    }
+    return _plan.channel(_slot);
+  }
+
+  void noteResult(uint8_t seq, bool ok, uint32_t nowMs) {
+    if (!_searching && !_ackLostProbe) {
+      const int16_t target = ok ? 0 : 256;
+      _lossQ8[_slot] = (uint16_t)((int16_t)_lossQ8[_slot] + ((target - (int16_t)_lossQ8[_slot]) >> 3));
+      if (_samples[_slot] < 255) _samples[_slot]++;
+    }
+
+    if (ok) {
+      if (_hasStaged) applyMask(_staged, nowMs);
+      _lastAckSeq = seq;
+      _fails = 0;
+      _searching = false;
+      _lastOkMs = nowMs;
+    } else {
+      if (_fails == 0) _alts = 0;
+      if (_alts < ALTS) {
+        _altSeq[_alts] = (uint8_t)(seq + 1);
+        _altMs[_alts] = nowMs;
+        _alts++;
+      }
+      if (_fails < 255) _fails++;
+    }
+    _hasStaged = false;
+  }
+
+  // Proposed blacklist for TB_HOP_CFG; send it with stageMask() set so the
+  // mask is taken (together with the RX) only if that frame is acked.
+  bool wantMask(uint32_t nowMs, uint16_t& outMask) {
+    if (_searching || nowMs - _lastEvalMs < EVAL_MS) return false;
+    _lastEvalMs = nowMs;
+
+    uint16_t mask = _plan.mask();
+    int8_t worst = -1;
+    for (uint8_t s = 0; s < TB_HOP_LEN; s++) {
+      if (!_plan.active(s)) {
+        if (nowMs - _blSinceMs[s] >= BL_HOLD_MS) mask &= (uint16_t)~(1u << s);
+      } else if (_samples[s] >= BL_MIN_SAMPLES && _lossQ8[s] > BL_LOSS_Q8 &&
+                 (worst < 0 || _lossQ8[s] > _lossQ8[worst])) {
+        worst = (int8_t)s;
+      }
+    }
+    if (worst >= 0 && TbHopPlan::validMask(mask | (1u << worst))) {
+      mask |= (uint16_t)(1u << worst);
+    }
+
+    if (mask == _plan.mask()) return false;
+    outMask = mask;
+    return true;
+  }
+
+  void stageMask(uint16_t mask) {
+    _staged = mask;
+    _hasStaged = true;
+  }
+
+  const TbHopPlan& plan() const { return _plan; }
+  uint8_t slot() const { return _slot; }
+  bool searching() const { return _searching; }
+  uint8_t lossPct(uint8_t slot) const { return (uint8_t)(((uint32_t)_lossQ8[slot] * 100UL) >> 8); }
+  uint8_t samples(uint8_t slot) const { return _samples[slot]; }
+
+  // ms until a blacklisted slot is proposed back in (0 = active or due)
+  uint32_t blacklistLeftMs(uint8_t slot, uint32_t nowMs) const {
+    if (_plan.active(slot)) return 0;
+    const uint32_t held = nowMs - _blSinceMs[slot];
+    return (held >= BL_HOLD_MS) ? 0 : BL_HOLD_MS - held;
+  }
+
+private:
+  static constexpr uint32_t EVAL_MS        = 1000;
+  static constexpr uint32_t BL_HOLD_MS     = 10000;
+  static constexpr uint16_t BL_LOSS_Q8     = 102;   // 40 %
+  static constexpr uint8_t  BL_MIN_SAMPLES = 8;
+  static constexpr uint8_t  ALTS           = 6;     // lost-ACK hypotheses kept
+
+  TbHopPlan _plan;
+  uint8_t  _slot = 0;           // slot of the current attempt
+  uint8_t  _lastAckSeq = 0;     // on-air seq of the last acked frame
+  uint8_t  _altSeq[ALTS] = {0}; // seq after each failed frame sent where the RX waits
+  uint32_t _altMs[ALTS] = {0};
+  uint8_t  _alts = 0;
+  uint8_t  _fails = 0;
+  bool     _ackLostProbe = false;
+  bool     _searching = false;
+  uint32_t _lastOkMs = 0;
+  uint32_t _lastEvalMs = 0;
+
+  uint16_t _staged = 0;
+  bool     _hasStaged = false;
+
+  uint16_t _lossQ8[TB_HOP_LEN] = {0};
+  uint8_t  _samples[TB_HOP_LEN] = {0};
+  uint32_t _blSinceMs[TB_HOP_LEN] = {0};
+
+  void resetSlotStats() {
+    memset(_lossQ8, 0, sizeof(_lossQ8));
+    memset(_samples, 0, sizeof(_samples));
+  }
+
+  void applyMask(uint16_t mask, uint32_t nowMs) {
+    for (uint8_t s = 0; s < TB_HOP_LEN; s++) {
+      const uint16_t bit = (uint16_t)(1u << s);
+      if ((mask & bit) && !(_plan.mask() & bit)) {
+        _blSinceMs[s] = nowMs;
+      } else if (!(mask & bit) && (_plan.mask() & bit)) {
+        _lossQ8[s] = 0;   // reinstated: re-measure from scratch
+        _samples[s] = 0;
+      }
+    }
+    _plan.setMask(mask);
+  }
+};
+
+// TbHopFollower (RX): listens on the slot of the next seq it expects. A good
+// frame sets that to its seq + 1; a frame that failed its checks (seq not
+// trusted) and every TB_HOP_COAST_MS of silence step it by one. After
+// TB_LINK_LOST_MS without a frame it drops the blacklist and parks on one slot
+// at a time (TB_HOP_SCAN_DWELL_MS each) until the TX's seq walk reaches it.
+class TbHopFollower {
+public:
+  void begin(uint32_t nowMs) {
+    _plan.begin(TB_HOP_SEED);
+    _next = 0;
+    _coast = 0;
+    _locked = false;
+    _sinceMs = nowMs;
+  }
+
+  // A frame was read on channel(); seqValid = it passed its checks
+  void noteRx(uint8_t seq, bool seqValid, uint32_t nowMs) {
+    _next = seqValid ? (uint8_t)(seq + 1) : (uint8_t)(_next + 1);
+    _coast = 0;
+    _locked = true;
+    _sinceMs = nowMs;
+  }
+
+  // Returns true when channel() changed
+  bool tick(uint32_t nowMs) {
+    if (_locked) {
+      const uint32_t quiet = nowMs - _sinceMs;
+      if (quiet >= TB_LINK_LOST_MS) {
+        _locked = false;
+        _plan.setMask(0);
+        _sinceMs = nowMs;
+        return false;   // park on the expected slot first
+      }
+      if (quiet < (uint32_t)(_coast + 1) * TB_HOP_COAST_MS) return false;
+      _coast++;
+      _next++;
+      return true;
+    }
+    if (nowMs - _sinceMs < TB_HOP_SCAN_DWELL_MS) return false;
+    _next++;
+    _sinceMs = nowMs;
+    return true;
+  }
+
+  void setMask(uint16_t mask) { _plan.setMask(mask); }
+
+  uint8_t channel() const { return _plan.channel(slot()); }
+  uint8_t slot() const { return _plan.slotForSeq(_next); }
+  bool locked() const { return _locked; }
+
+private:
+  TbHopPlan _plan;
+  uint8_t   _next = 0;   // on-air seq expected next
+  uint8_t   _coast = 0;
+  bool      _locked = false;
+  uint32_t  _sinceMs = 0;
+};
+
+// =============================================================================
+// CRC16
+// =============================================================================
+// CRC16-CCITT (0x1021), init 0xFFFF
+//
+// Selectable backends (TB_CRC_BACKEND); all produce bit-identical output:
+//   0 = bitwise  : original 8 shift/branch iterations per byte, no table
+//   1 = table256 : one lookup per byte, 512 B table in flash (PROGMEM)
+//   2 = nibble   : two lookups per byte, own 32 B table (kTbCrcNibble); the 512 B table is
+//                  then unreferenced and dropped unless TB_CRC_BENCH pulls in the others
+//   3 = slice4   : four bytes per step, 3 x 256 derived tables built in RAM on first use (1.5 KB)
+static const uint16_t kTbCrcTable[256] PROGMEM = {
+  0x0000, 0x1021, 0x2042, 0x3063, 0x4084, 0x50A5, 0x60C6, 0x70E7,
+  0x8108, 0x9129, 0xA14A, 0xB16B, 0xC18C, 0xD1AD, 0xE1CE, 0xF1EF,
+  0x1231, 0x0210, 0x3273, 0x2252, 0x52B5, 0x4294, 0x72F7, 0x62D6,
+  0x9339, 0x8318, 0xB37B, 0xA35A, 0xD3BD, 0xC39C, 0xF3FF, 0xE3DE,
+  0x2462, 0x3443, 0x0420, 0x1401, 0x64E6, 0x74C7, 0x44A4, 0x5485,
+  0xA56A, 0xB54B, 0x8528, 0x9509, 0xE5EE, 0xF5CF, 0xC5AC, 0xD58D,
+  0x3653, 0x2672, 0x1611, 0x0630, 0x76D7, 0x66F6, 0x5695, 0x46B4,
+  0xB75B, 0xA77A, 0x9719, 0x8738, 0xF7DF, 0xE7FE, 0xD79D, 0xC7BC,
+  0x48C4, 0x58E5, 0x6886, 0x78A7, 0x0840, 0x1861, 0x2802, 0x3823,
+  0xC9CC, 0xD9ED, 0xE98E, 0xF9AF, 0x8948, 0x9969, 0xA90A, 0xB92B,
+  0x5AF5, 0x4AD4, 0x7AB7, 0x6A96, 0x1A71, 0x0A50, 0x3A33, 0x2A12,
+  0xDBFD, 0xCBDC, 0xFBBF, 0xEB9E, 0x9B79, 0x8B58, 0xBB3B, 0xAB1A,
+  0x6CA6, 0x7C87, 0x4CE4, 0x5CC5, 0x2C22, 0x3C03, 0x0C60, 0x1C41,
+  0xEDAE, 0xFD8F, 0xCDEC, 0xDDCD, 0xAD2A, 0xBD0B, 0x8D68, 0x9D49,
+  0x7E97, 0x6EB6, 0x5ED5, 0x4EF4, 0x3E13, 0x2E32, 0x1E51, 0x0E70,
+  0xFF9F, 0xEFBE, 0xDFDD, 0xCFFC, 0xBF1B, 0xAF3A, 0x9F59, 0x8F78,
+  0x9188, 0x81A9, 0xB1CA, 0xA1EB, 0xD10C, 0xC12D, 0xF14E, 0xE16F,
+  0x1080, 0x00A1, 0x30C2, 0x20E3, 0x5004, 0x4025, 0x7046, 0x6067,
+  0x83B9, 0x9398, 0xA3FB, 0xB3DA, 0xC33D, 0xD31C, 0xE37F, 0xF35E,
+  0x02B1, 0x1290, 0x22F3, 0x32D2, 0x4235, 0x5214, 0x6277, 0x7256,
+  0xB5EA, 0xA5CB, 0x95A8, 0x8589, 0xF56E, 0xE54F, 0xD52C, 0xC50D,
+  0x34E2, 0x24C3, 0x14A0, 0x0481, 0x7466, 0x6447, 0x5424, 0x4405,
+  0xA7DB, 0xB7FA, 0x8799, 0x97B8, 0xE75F, 0xF77E, 0xC71D, 0xD73C,
+  0x26D3, 0x36F2, 0x0691, 0x16B0, 0x6657, 0x7676, 0x4615, 0x5634,
+  0xD94C, 0xC96D, 0xF90E, 0xE92F, 0x99C8, 0x89E9, 0xB98A, 0xA9AB,
+  0x5844, 0x4865, 0x7806, 0x6827, 0x18C0, 0x08E1, 0x3882, 0x28A3,
+  0xCB7D, 0xDB5C, 0xEB3F, 0xFB1E, 0x8BF9, 0x9BD8, 0xABBB, 0xBB9A,
+  0x4A75, 0x5A54, 0x6A37, 0x7A16, 0x0AF1, 0x1AD0, 0x2AB3, 0x3A92,
+  0xFD2E, 0xED0F, 0xDD6C, 0xCD4D, 0xBDAA, 0xAD8B, 0x9DE8, 0x8DC9,
+  0x7C26, 0x6C07, 0x5C64, 0x4C45, 0x3CA2, 0x2C83, 0x1CE0, 0x0CC1,
+  0xEF1F, 0xFF3E, 0xCF5D, 0xDF7C, 0xAF9B, 0xBFBA, 0x8FD9, 0x9FF8,
+  0x6E17, 0x7E36, 0x4E55, 0x5E74, 0x2E93, 0x3EB2, 0x0ED1, 0x1EF0,
+};
+
+// CRC of a single nibble shifted to the top: the first 16 entries of kTbCrcTable
+static const uint16_t kTbCrcNibble[16] PROGMEM = {
+  0x0000, 0x1021, 0x2042, 0x3063, 0x4084, 0x50A5, 0x60C6, 0x70E7,
+  0x8108, 0x9129, 0xA14A, 0xB16B, 0xC18C, 0xD1AD, 0xE1CE, 0xF1EF,
+};
+
+static inline uint16_t TbCrcTab(uint8_t i) {
+  return pgm_read_word(&kTbCrcTable[i]);
+}
+
+static inline uint16_t TbCrc16Bitwise(const uint8_t* data, size_t len) {
+  uint16_t crc = 0xFFFF;
+  for (size_t i = 0; i < len; i++) {
+    crc ^= (uint16_t)data[i] << 8;
+    for (uint8_t b = 0; b < 8; b++) {
+      crc = (crc & 0x8000) ? (uint16_t)((crc << 1) ^ 0x1021) : (uint16_t)(crc << 1);
+    }
+  }
+  return crc;
+}
+
+static inline uint16_t TbCrc16Table256(const uint8_t* data, size_t len) {
+  uint16_t crc = 0xFFFF;
+  for (size_t i = 0; i < len; i++) {
+    crc = (uint16_t)(crc << 8) ^ TbCrcTab((uint8_t)(crc >> 8) ^ data[i]);
+  }
+  return crc;
+}
+
+static inline uint16_t TbCrc16Nibble(const uint8_t* data, size_t len) {
+  uint16_t crc = 0xFFFF;
+  for (size_t i = 0; i < len; i++) {
+    crc ^= (uint16_t)data[i] << 8;
+    crc = (uint16_t)(crc << 4) ^ pgm_read_word(&kTbCrcNibble[crc >> 12]);
+    crc = (uint16_t)(crc << 4) ^ pgm_read_word(&kTbCrcNibble[crc >> 12]);
+  }
+  return crc;
+}
+
+static inline uint16_t TbCrc16Slice4(const uint8_t* data, size_t len) {
+  // s[k][i] = CRC register after byte i followed by (k+1) zero bytes
+  static uint16_t s[3][256];
+  static bool built = false;
+  if (!built) {
+    for (uint16_t i = 0; i < 256; i++) {
+      uint16_t c = TbCrcTab((uint8_t)i);
+      for (uint8_t k = 0; k < 3; k++) {
+        c = (uint16_t)(c << 8) ^ TbCrcTab((uint8_t)(c >> 8));
+        s[k][i] = c;
+      }
+    }
+    built = true;
+  }
+
+  uint16_t crc = 0xFFFF;
+  size_t i = 0;
+  for (; i + 4 <= len; i += 4) {
+    crc = (uint16_t)(s[2][(uint8_t)(crc >> 8) ^ data[i + 0]] ^
+                     s[1][(uint8_t)crc        ^ data[i + 1]] ^
+                     s[0][data[i + 2]] ^
+                     TbCrcTab(data[i + 3]));
+  }
+  for (; i < len; i++) {
+    crc = (uint16_t)(crc << 8) ^ TbCrcTab((uint8_t)(crc >> 8) ^ data[i]);
+  }
+  return crc;
+}
+
+static uint16_t TbCrc16Ccitt(const uint8_t* data, size_t len) {
+#if TB_CRC_BACKEND == 0
+  return TbCrc16Bitwise(data, len);
+#elif TB_CRC_BACKEND == 1
+  return TbCrc16Table256(data, len);
+#elif TB_CRC_BACKEND == 2
+  return TbCrc16Nibble(data, len);
+#elif TB_CRC_BACKEND == 3
+  return TbCrc16Slice4(data, len);
+#else
+#error "TB_CRC_BACKEND must be 0..3"
+#endif
+}
+
+// =============================================================================
+// LITTLE-ENDIAN FIELD ACCESS
+// =============================================================================
+// Fields are read byte-wise, so views need no alignment on the radio buffer.
+static inline uint16_t TbLoadLe16(const uint8_t* p) {
+  return (uint16_t)p[0] | ((uint16_t)p[1] << 8);
+}
+
+static inline uint32_t TbLoadLe32(const uint8_t* p) {
+  return (uint32_t)TbLoadLe16(p) | ((uint32_t)TbLoadLe16(p + 2) << 16);
+}
+
+static inline void TbStoreLe32(uint8_t* p, uint32_t v) {
+  p[0] = (uint8_t)v;
+  p[1] = (uint8_t)(v >> 8);
+  p[2] = (uint8_t)(v >> 16);
+  p[3] = (uint8_t)(v >> 24);
+}
+
+// =============================================================================
+// ZERO-COPY VIEWS (RX: frames + CMD payload, TX: ACKs)
+// =============================================================================
+// Validate in place over the radio buffer; fields are read byte-wise (LE), so no
+// alignment requirement and no header/payload memcpy.
+class TbFrameView {
+public:
+  // Same checks, order and statuses as the old memcpy-based TbParseFrame
+  // (test_rx cross-checks the two on a corpus)
+  TbStatus parse(const uint8_t* frame, uint8_t frameLen) {
+    _f = frame;
+    _n = frameLen;
+    if (frameLen < TB_HDR_LEN + TB_CRC_LEN) return TB_S_BAD_LEN;
+    if (ver() != TB_VER) return TB_S_BAD_VER;
+
+    const uint8_t expected = (uint8_t)(TB_HDR_LEN + len() + TB_CRC_LEN);
+    if (expected != frameLen) return TB_S_BAD_LEN;
+    if (len() > TB_MAX_PAY) return TB_S_BAD_LEN;
+
+    const uint8_t totalNoCrc = (uint8_t)(TB_HDR_LEN + len());
+    if (TbLoadLe16(_f + totalNoCrc) != TbCrc16Ccitt(_f, totalNoCrc)) return TB_S_BAD_CRC;
+    return TB_S_OK;
+  }
+
+  // Header fields are readable whenever the frame is at least minimum length
+  bool hasHdr() const { return _f && _n >= TB_HDR_LEN + TB_CRC_LEN; }
+
+  uint8_t ver()   const { return _f[offsetof(TbHdr, ver)]; }
+  uint8_t type()  const { return _f[offsetof(TbHdr, type)]; }
+  uint8_t flags() const { return _f[offsetof(TbHdr, flags)]; }
+  uint8_t seq()   const { return _f[offsetof(TbHdr, seq)]; }
+  uint8_t len()   const { return _f[offsetof(TbHdr, len)]; }
+  const uint8_t* payload() const { return _f + TB_HDR_LEN; }
+
+private:
+  const uint8_t* _f = nullptr;
+  uint8_t _n = 0;
+};
+
+// Typed accessors over a TbCmdV1 payload inside a validated frame
+class TbCmdView {
+public:
+  explicit TbCmdView(const uint8_t* p) : _p(p) {}
+
+  int8_t  throttlePct() const { return (int8_t)_p[offsetof(TbCmdV1, throttlePct)]; }
+  int8_t  rudderPct()   const { return (int8_t)_p[offsetof(TbCmdV1, rudderPct)]; }
+  uint8_t acc(uint8_t i) const { return _p[offsetof(TbCmdV1, acc) + i]; }
+  uint8_t arm()         const { return _p[offsetof(TbCmdV1, arm)]; }
+
+private:
+  const uint8_t* _p;
+};
+
+// Zero-copy ACK view: validates in place over the radio buffer. Fields are read
+// byte-wise (LE), so there is no alignment requirement on the buffer.
+class TbAckView {
+public:
+  bool parse(const uint8_t* buf, uint8_t len) {
+    _p = buf;
+    if (len != TB_ACK_LEN) return false;
+    if (ver() != TB_VER) return false;
+    if (type() != TB_ACK) return false;
+    return TbCrc16Ccitt(_p, offsetof(TbAckV2, crc16)) == crc16();
+  }
+
+  uint8_t  ver()       const { return _p[offsetof(TbAckV2, ver)]; }
+  uint8_t  type()      const { return _p[offsetof(TbAckV2, type)]; }
+  uint8_t  seqEcho()   const { return _p[offsetof(TbAckV2, seqEcho)]; }
+  uint8_t  status()    const { return _p[offsetof(TbAckV2, status)]; }
+  uint16_t rxOk()      const { return TbLoadLe16(_p + offsetof(TbAckV2, rxOk)); }
+  uint16_t rxBad()     const { return TbLoadLe16(_p + offsetof(TbAckV2, rxBad)); }
+  uint16_t vSys_mV()   const { return TbLoadLe16(_p + offsetof(TbAckV2, vSys_mV)); }
+  uint16_t vProp_mV()  const { return TbLoadLe16(_p + offsetof(TbAckV2, vProp_mV)); }
+  uint16_t iSys_mA()   const { return TbLoadLe16(_p + offsetof(TbAckV2, iSys_mA)); }
+  int16_t  tMotor_cC() const { return (int16_t)TbLoadLe16(_p + offsetof(TbAckV2, tMotor_cC)); }
+  int16_t  tEsc_cC()   const { return (int16_t)TbLoadLe16(_p + offsetof(TbAckV2, tEsc_cC)); }
+  uint16_t waterRaw()  const { return TbLoadLe16(_p + offsetof(TbAckV2, waterRaw)); }
+  uint16_t crc16()     const { return TbLoadLe16(_p + offsetof(TbAckV2, crc16)); }
+
+private:
+  const uint8_t* _p = nullptr;
+};
+
+// Zero-copy view over a paged ACK (TB_ACK_PAGED); body() points at the page struct.
+class TbAckPagedView {
+public:
+  bool parse(const uint8_t* buf, uint8_t len) {
+    _p = buf;
+    if (len < TB_ACKP_HDR_LEN + TB_CRC_LEN) return false;
+    if (ver() != TB_VER) return false;
+    if (type() != TB_ACK_PAGED) return false;
+    if (page() >= TB_PAGE_COUNT) return false;
+
+    const uint8_t noCrc = (uint8_t)(TB_ACKP_HDR_LEN + TbAckPageLen(page()));
+    if (len != noCrc + TB_CRC_LEN) return false;
+    return TbLoadLe16(_p + noCrc) == TbCrc16Ccitt(_p, noCrc);
+  }
+
+  uint8_t  ver()      const { return _p[offsetof(TbAckPagedHdr, ver)]; }
+  uint8_t  type()     const { return _p[offsetof(TbAckPagedHdr, type)]; }
+  uint8_t  seqEcho()  const { return _p[offsetof(TbAckPagedHdr, seqEcho)]; }
+  uint8_t  status()   const { return _p[offsetof(TbAckPagedHdr, status)]; }
+  uint8_t  page()     const { return _p[offsetof(TbAckPagedHdr, page)]; }
+  uint16_t vSys_mV()  const { return TbLoadLe16(_p + offsetof(TbAckPagedHdr, vSys_mV)); }
+  uint16_t vProp_mV() const { return TbLoadLe16(_p + offsetof(TbAckPagedHdr, vProp_mV)); }
+  uint16_t iSys_mA()  const { return TbLoadLe16(_p + offsetof(TbAckPagedHdr, iSys_mA)); }
+  const uint8_t* body() const { return _p + TB_ACKP_HDR_LEN; }
+
+private:
+  const uint8_t* _p = nullptr;
+};
@@ -0,0 +1,162 @@
+// Host shim for the Arduino/AVR API used by the sketches (test/host only).
+// Header-only, C++17 inline globals: one test = one translation unit that
+// includes a sketch. Clock is driven by the test through g_hostUs.
+#pragma once
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <algorithm>
+
+using std::min;
+using std::max;
+
+typedef uint8_t byte;
+typedef bool boolean;
+
+#define F_CPU 16000000UL
+
+#define HIGH 1
+#define LOW 0
+#define INPUT 0
+#define OUTPUT 1
+#define INPUT_PULLUP 2
+#define CHANGE 1
+#define FALLING 2
+#define RISING 3
+#define DEC 10
+#define HEX 16
+
+#define A0 54
+#define A1 55
+#define A2 56
+#define A3 57
+#define A8 62
+#define A9 63
+
+// ---- flash strings / PROGMEM (flat address space on the host)
+class __FlashStringHelper;
+#define F(s) (reinterpret_cast<const __FlashStringHelper*>(s))
+#define PROGMEM
+#define PSTR(s) (s)
+inline uint8_t  pgm_read_byte(const void* p)  { return *(const uint8_t*)p; }
+inline uint16_t pgm_read_word(const void* p)  { uint16_t v; memcpy(&v, p, 2); return v; }
+inline uint32_t pgm_read_dword(const void* p) { uint32_t v; memcpy(&v, p, 4); return v; }
+
+// ---- time (test-controlled)
+inline uint32_t g_hostUs = 0;
+inline uint32_t micros() { return g_hostUs; }
+inline uint32_t millis() { return g_hostUs / 1000u; }
+inline void delay(uint32_t ms) { g_hostUs += ms * 1000u; }
+inline void delayMicroseconds(unsigned us) { g_hostUs += us; }
+
+// ---- GPIO / analog (no hardware)
+inline int g_hostAnalog[70] = {0};
+inline void pinMode(uint8_t, uint8_t) {}
+inline void digitalWrite(uint8_t, uint8_t) {}
+inline int  digitalRead(uint8_t) { return HIGH; }
+inline int  analogRead(uint8_t pin) { return g_hostAnalog[pin % 70]; }
+inline void analogWrite(uint8_t, int) {}
+inline int  digitalPinToInterrupt(int pin) { return pin; }
+inline void attachInterrupt(int, void (*)(), int) {}
+inline void noInterrupts() {}
+inline void interrupts() {}
+inline void yield() {}
+inline long random(long hi) { return hi ? rand() % hi : 0; }
+inline long random(long lo, long hi) { return lo + random(hi - lo); }
+inline void randomSeed(unsigned long s) { srand((unsigned)s); }
+
+// ---- Serial (stdout; input empty). write() is virtual so tests can capture.
+class Print {
+public:
+  virtual ~Print() = default;
+  virtual size_t write(uint8_t c) { return (size_t)putchar(c); }
+  size_t print(const char* s) { size_t n = 0; while (*s) n += write((uint8_t)*s++); return n; }
+  size_t print(const __FlashStringHelper* s) { return print(reinterpret_cast<const char*>(s)); }
+  size_t print(char c) { return write((uint8_t)c); }
+  size_t print(int v, int base = DEC) { return fmt(base == HEX ? "%X" : "%d", v); }
+  size_t print(unsigned v, int base = DEC) { return fmt(base == HEX ? "%X" : "%u", v); }
+  size_t print(long v, int base = DEC) { return fmt(base == HEX ? "%lX" : "%ld", v); }
+  size_t print(unsigned long v, int base = DEC) { return fmt(base == HEX ? "%lX" : "%lu", v); }
+  size_t print(double v, int digits = 2) { return fmt("%.*f", digits, v); }
+  template <class T> size_t println(T v) { const size_t n = print(v); return n + println(); }
+  template <class T> size_t println(T v, int fmt) { const size_t n = print(v, fmt); return n + println(); }
+  size_t println() { return print("\r\n"); }
+
+private:
+  template <class... A> size_t fmt(const char* f, A... a) {
+    char buf[40];
+    snprintf(buf, sizeof(buf), f, a...);
+    return print(buf);
+  }
+};
+
+#define SERIAL_TX_BUFFER_SIZE 64
+inline int g_hostSerialRoom = SERIAL_TX_BUFFER_SIZE - 1;   // availableForWrite()
+
+class HardwareSerial : public Print {
+public:
+  void begin(unsigned long) {}
+  explicit operator bool() const { return true; }
+  int available() { return 0; }
+  int read() { return -1; }
+  int availableForWrite() { return g_hostSerialRoom; }
+  void flush() { fflush(stdout); }
+};
+inline HardwareSerial Serial;
+
+// ---- AVR registers (Mega2560 bit positions; plain memory on the host)
+#define _BV(b) (1u << (b))
+#define ISR(vec) extern "C" void vec(void)
+#define ADC_vect          host_ADC_vect
+#define TIMER1_COMPA_vect host_TIMER1_COMPA_vect
+
+inline volatile uint8_t  ADMUX, ADCSRA, ADCSRB, DIDR0, DIDR2;
+inline volatile uint16_t ADC;
+inline volatile uint8_t  TCCR0A, TCCR2A, TCCR3A, TCCR1A, TCCR1B, TIMSK1, TCCR4A, TCCR4B;
+inline volatile uint8_t  OCR0B, OCR2A;
+inline volatile uint16_t OCR1A, TCNT1, OCR3A, OCR3B, OCR4A, OCR4B, OCR4C, ICR4;
+inline volatile uint8_t  PORTA, PORTG, PORTH;
+
+#define REFS0 6
+#define ADEN  7
+#define ADSC  6
+#define ADATE 5
+#define ADIF  4
+#define ADIE  3
+#define ADPS2 2
+#define ADPS1 1
+#define ADPS0 0
+#define MUX5  3
+
+#define WGM12  3
+#define CS11   1
+#define CS10   0
+#define OCIE1A 1
+
+#define COM0B1 5
+#define COM2A1 7
+#define COM3A1 7
+#define COM3B1 5
+#define COM4A1 7
+#define COM4B1 5
+#define COM4C1 3
+#define WGM40  0
+#define WGM41  1
+#define WGM42  3
+#define WGM43  4
+#define CS40   0
+
+#define PA1 1
+#define PA3 3
+#define PG5 5
+#define PH3 3
+#define PH4 4
+#define PH5 5
+
+// TbFreeSram(): heap/stack symbols from the AVR libc linker script
+inline char  __heap_start;
+inline char* __brkval = nullptr;
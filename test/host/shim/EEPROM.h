@@ -0,0 +1,10 @@
+#pragma once
+#include <Arduino.h>
+
+class EEPROMClass {
+public:
+  template <class T> T& get(int addr, T& t) { memcpy(&t, mem + addr, sizeof(T)); return t; }
+  template <class T> const T& put(int addr, const T& t) { memcpy(mem + addr, &t, sizeof(T)); return t; }
+  uint8_t mem[4096] = {0};
+};
+inline EEPROMClass EEPROM;
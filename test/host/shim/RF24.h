@@ -0,0 +1,52 @@
+// RF24 API surface used by the sketches; frames are fed/collected by the test.
+#pragma once
+#include <Arduino.h>
+#include <deque>
+#include <vector>
+
+typedef enum { RF24_PA_MIN = 0, RF24_PA_LOW, RF24_PA_HIGH, RF24_PA_MAX, RF24_PA_ERROR } rf24_pa_dbm_e;
+typedef enum { RF24_1MBPS = 0, RF24_2MBPS, RF24_250KBPS } rf24_datarate_e;
+
+class RF24 {
+public:
+  RF24(uint16_t, uint16_t) {}
+  bool begin() { return true; }
+  void setChannel(uint8_t ch) { channel = ch; }
+  uint8_t getChannel() { return channel; }
+  void setPALevel(uint8_t, bool = true) {}
+  bool setDataRate(rf24_datarate_e) { return true; }
+  void setAutoAck(bool) {}
+  void setRetries(uint8_t, uint8_t) {}
+  void enableDynamicPayloads() {}
+  void enableAckPayload() {}
+  void openReadingPipe(uint8_t, const uint8_t*) {}
+  void openWritingPipe(const uint8_t*) {}
+  void startListening() {}
+  void stopListening() {}
+  void maskIRQ(bool, bool, bool) {}
+  bool available() { return !rx.empty(); }
+  bool available(uint8_t* pipe) { if (pipe) *pipe = 1; return !rx.empty(); }
+  uint8_t getDynamicPayloadSize() { return rx.empty() ? 0 : (uint8_t)rx.front().size(); }
+  void read(void* buf, uint8_t len) {
+    if (rx.empty()) return;
+    memcpy(buf, rx.front().data(), std::min<size_t>(len, rx.front().size()));
+    rx.pop_front();
+  }
+  bool writeAckPayload(uint8_t, const void* buf, uint8_t len) {
+    if (ack.size() >= 3) return false;
+    ack.emplace_back((const uint8_t*)buf, (const uint8_t*)buf + len);
+    return true;
+  }
+  bool isFifo(bool aboutTx, bool checkEmpty) {
+    const bool empty = aboutTx ? ack.empty() : rx.empty();
+    const bool full = aboutTx ? ack.size() >= 3 : rx.size() >= 3;
+    return checkEmpty ? empty : full;
+  }
+  uint8_t flush_rx() { rx.clear(); return 0; }
+  uint8_t flush_tx() { ack.clear(); return 0; }
+  void whatHappened(bool& txOk, bool& txFail, bool& rxReady) { txOk = txFail = false; rxReady = !rx.empty(); }
+
+  std::deque<std::vector<uint8_t>> rx;  // frames waiting in the RX FIFO
+  std::deque<std::vector<uint8_t>> ack; // ACK payloads waiting in the TX FIFO
+  uint8_t channel = 0;
+};
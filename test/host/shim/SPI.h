@@ -0,0 +1,8 @@
+#pragma once
+#include <Arduino.h>
+
+class SPIClass {
+public:
+  void begin() {}
+};
+inline SPIClass SPI;
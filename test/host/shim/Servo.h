@@ -0,0 +1,9 @@
+#pragma once
+#include <Arduino.h>
+
+class Servo {
+public:
+  uint8_t attach(int) { return 0; }
+  void writeMicroseconds(int us) { lastUs = us; }
+  int lastUs = 0;
+};
@@ -0,0 +1,49 @@
+// Minimal check harness for the host tests: CHECK() records, main returns
+// the failure count so ctest sees a non-zero exit. TbHostCycles() times the
+// host benchmark prints.
+#pragma once
+#include <stdint.h>
+#include <stdio.h>
+
+// Host timing for the benchmark prints: TSC cycles on x86, else nanoseconds
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+static inline uint64_t TbHostCycles() { return __rdtsc(); }
+static const char* const kTbHostCycleUnit = "cyc";
+#else
+#include <chrono>
+static inline uint64_t TbHostCycles() {
+  return (uint64_t)std::chrono::duration_cast<std::chrono::nanoseconds>(
+    std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+static const char* const kTbHostCycleUnit = "ns";
+#endif
+
+static int g_checks = 0;
+static int g_failures = 0;
+
+#define CHECK(cond) TbCheck((cond), #cond, __FILE__, __LINE__)
+#define CHECK_EQ(a, b) TbCheckEq((long)(a), (long)(b), #a " == " #b, __FILE__, __LINE__)
+
+static inline bool TbCheck(bool ok, const char* what, const char* file, int line) {
+  g_checks++;
+  if (!ok) {
+    g_failures++;
+    fprintf(stderr, "%s:%d: FAILED: %s\n", file, line, what);
+  }
+  return ok;
+}
+
+static inline bool TbCheckEq(long a, long b, const char* what, const char* file, int line) {
+  g_checks++;
+  if (a != b) {
+    g_failures++;
+    fprintf(stderr, "%s:%d: FAILED: %s (%ld vs %ld)\n", file, line, what, a, b);
+  }
+  return a == b;
+}
+
+static inline int TbCheckReport(const char* name) {
+  fprintf(stderr, "%s: %d checks, %d failed\n", name, g_checks, g_failures);
+  return g_failures ? 1 : 0;
+}
@@ -0,0 +1,53 @@
+// RX sketch built with -DTB_MOTOR_PWM16=1: Timer4 register setup and the
+// dithered bridge driver, checked against the Mega2560 datasheet values.
+#include <Arduino.h>
+#include "../../TugbotFeb21RXGood/TugbotFeb21RXGood.cpp"
+#include "tb_check.h"
+
+static_assert(TB_MOTOR_PWM16, "build this target with -DTB_MOTOR_PWM16=1");
+
+static void testTimer4Setup() {
+  TCCR4A = TCCR4B = 0xFF;
+  ICR4 = 0;
+  ActuatorOutputs out;
+  out.begin();
+  CHECK_EQ(TCCR4A, _BV(WGM41));                               // mode 14, compare outputs detached
+  CHECK_EQ(TCCR4B, _BV(WGM43) | _BV(WGM42) | _BV(CS40));      // fast PWM, TOP = ICR4, clk/1
+  CHECK_EQ(ICR4, 799);                                        // 16 MHz / 800 = 20 kHz
+  CHECK_EQ(PORTH & (_BV(PH3) | _BV(PH4) | _BV(PH5)), 0);
+}
+
+static void testBridgeDrive() {
+  ActuatorOutputs out;
+  out.begin();
+  MotorPwm16 m;
+  m.begin();
+
+  m.drive(1, TB_DUTY12_MAX);                                  // full ahead: LPWM high all period
+  CHECK(TCCR4A & _BV(COM4A1));
+  CHECK(!(TCCR4A & _BV(COM4C1)));
+  CHECK_EQ(OCR4A, 799);
+
+  // Mean over one dither cycle matches the 12-bit duty to a quarter count
+  const uint16_t duty12 = 1000;
+  uint32_t high = 0;
+  for (uint8_t k = 0; k < (1u << TB_MOTOR_DITHER_BITS); k++) {
+    m.drive(-1, duty12);
+    CHECK(TCCR4A & _BV(COM4C1));
+    CHECK(!(TCCR4A & _BV(COM4A1)));                           // idle side detached ...
+    CHECK_EQ(PORTH & _BV(PH3), 0);                            // ... and parked low
+    high += OCR4C + 1u;
+  }
+  const double want = (double)duty12 * TB_T4_COUNTS / TB_DUTY12_MAX * (1u << TB_MOTOR_DITHER_BITS);
+  CHECK(fabs((double)high - want) <= 1.0);
+
+  m.stop();
+  CHECK_EQ(TCCR4A, _BV(WGM41));
+  CHECK_EQ(PORTH & (_BV(PH3) | _BV(PH5)), 0);
+}
+
+int main() {
+  testTimer4Setup();
+  testBridgeDrive();
+  return TbCheckReport("test_motor_pwm16");
+}
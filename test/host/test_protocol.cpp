@@ -0,0 +1,231 @@
+// TbProtocol.h on its own: CRC backends (+ host cycles/byte), LE helpers, ACK
+// page sizes, hop plan.
+#include <Arduino.h>
+#include <RF24.h>
+#include "TbProtocol.h"
+#include "tb_check.h"
+
+static void testCrcKnownAnswer() {
+  // CRC-16/CCITT-FALSE check value
+  const uint8_t msg[] = { '1', '2', '3', '4', '5', '6', '7', '8', '9' };
+  CHECK_EQ(TbCrc16Bitwise(msg, sizeof(msg)), 0x29B1);
+  CHECK_EQ(TbCrc16Table256(msg, sizeof(msg)), 0x29B1);
+  CHECK_EQ(TbCrc16Nibble(msg, sizeof(msg)), 0x29B1);
+  CHECK_EQ(TbCrc16Slice4(msg, sizeof(msg)), 0x29B1);
+  CHECK_EQ(TbCrc16Ccitt(msg, 0), 0xFFFF);
+}
+
+static void testCrcBackendsAgree() {
+  uint8_t buf[TB_MAX_AIR];
+  uint32_t x = 0x12345678u;
+  for (int run = 0; run < 2000; run++) {
+    for (uint8_t i = 0; i < sizeof(buf); i++) {
+      x = x * 1664525u + 1013904223u;
+      buf[i] = (uint8_t)(x >> 24);
+    }
+    const uint8_t len = (uint8_t)(run % (TB_MAX_AIR + 1));
+    const uint16_t ref = TbCrc16Bitwise(buf, len);
+    CHECK_EQ(TbCrc16Table256(buf, len), ref);
+    CHECK_EQ(TbCrc16Nibble(buf, len), ref);
+    CHECK_EQ(TbCrc16Slice4(buf, len), ref);
+  }
+}
+
+static void testCrcNibbleTable() {
+  for (uint8_t i = 0; i < 16; i++) CHECK_EQ(pgm_read_word(&kTbCrcNibble[i]), TbCrcTab(i));
+}
+
+// Host counterpart of TB_CRC_BENCH: cycles/byte per backend over full-size
+// frames (TSC, so nominal-clock cycles). Host numbers rank the backends; the
+// AVR numbers still come from the target.
+static void benchCrcBackends() {
+  struct Backend { const char* name; uint16_t (*fn)(const uint8_t*, size_t); };
+  static const Backend kBackends[] = {
+    { "bitwise", TbCrc16Bitwise }, { "table256", TbCrc16Table256 },
+    { "nibble", TbCrc16Nibble }, { "slice4", TbCrc16Slice4 },
+  };
+  static constexpr uint32_t RUNS = 200000;
+  uint8_t buf[TB_MAX_AIR];
+  for (uint8_t i = 0; i < sizeof(buf); i++) buf[i] = (uint8_t)(i * 37 + 11);
+
+  printf("CRC %s/B (host, %u B frames):", kTbHostCycleUnit, (unsigned)sizeof(buf));
+  for (const Backend& b : kBackends) {
+    volatile uint16_t sink = 0;
+    sink = (uint16_t)(sink ^ b.fn(buf, sizeof(buf)));   // slice4 builds its tables here
+    const uint64_t c0 = TbHostCycles();
+    for (uint32_t r = 0; r < RUNS; r++) {
+      buf[0] = (uint8_t)r;                              // keeps the call in the loop
+      sink = (uint16_t)(sink ^ b.fn(buf, sizeof(buf)));
+    }
+    const uint64_t cycles = TbHostCycles() - c0;
+    printf(" %s=%.2f", b.name, (double)cycles / ((double)RUNS * sizeof(buf)));
+    CHECK(cycles > 0);
+  }
+  printf("\n");
+}
+
+static void testLittleEndian() {
+  uint8_t b[4];
+  TbStoreLe32(b, 0xA1B2C3D4u);
+  CHECK_EQ(b[0], 0xD4);
+  CHECK_EQ(b[3], 0xA1);
+  CHECK_EQ(TbLoadLe16(b), 0xC3D4);
+  CHECK(TbLoadLe32(b) == 0xA1B2C3D4u);
+}
+
+static void testAckPagesFit() {
+  for (uint8_t p = 0; p < TB_PAGE_COUNT; p++) {
+    CHECK(TbAckPageLen(p) > 0);
+    CHECK(TB_ACKP_HDR_LEN + TbAckPageLen(p) + TB_CRC_LEN <= TB_MAX_AIR);
+  }
+}
+
+static void testHopPlan() {
+  TbHopPlan a, b;
+  a.begin(0xBEEF);
+  b.begin(0xBEEF);
+  for (uint8_t s = 0; s < TB_HOP_LEN; s++) {
+    CHECK_EQ(a.channel(s), b.channel(s));
+    CHECK(a.channel(s) >= TB_HOP_CH_MIN && a.channel(s) <= TB_HOP_CH_MAX);
+    for (uint8_t t = 0; t < s; t++) {
+      const int d = (int)a.channel(s) - (int)a.channel(t);
+      CHECK((d < 0 ? -d : d) >= TB_HOP_CH_SPACING);
+    }
+  }
+  a.setMask(1u << 3);
+  CHECK(!a.active(3));
+  CHECK_EQ(a.next(2), 4);
+  CHECK_EQ(a.activeCount(), TB_HOP_LEN - 1);
+}
+
+static void testHopSlotForSeq() {
+  TbHopPlan p;
+  p.begin(TB_HOP_SEED);
+  for (unsigned q = 0; q < 256; q++) CHECK_EQ(p.slotForSeq((uint8_t)q), q % TB_HOP_LEN);
+  p.setMask((1u << 4) | (1u << 5));
+  CHECK_EQ(p.slotForSeq(4), 6);
+  CHECK_EQ(p.slotForSeq(5), 6);
+  CHECK_EQ(p.slotForSeq(7), 7);
+  for (unsigned q = 0; q < 256; q++) CHECK(p.active(p.slotForSeq((uint8_t)q)));
+}
+
+// The real TbHopLeader against the real TbHopFollower, one frame per 20 ms
+struct HopLink {
+  TbHopLeader tx;
+  TbHopFollower rx;
+  uint8_t  seq = 1;
+  uint32_t ms = 0;
+
+  HopLink() {
+    tx.begin(0);
+    rx.begin(0);
+  }
+
+  // true when the RX heard the frame
+  bool send(bool loseFrame = false, bool loseAck = false) {
+    ms += 20;
+    rx.tick(ms);
+    const uint8_t ch = tx.pick(seq, ms);
+    const bool got = ch == rx.channel() && !loseFrame;
+    if (got) rx.noteRx(seq, true, ms);
+    tx.noteResult(seq, got && !loseAck, ms);
+    seq++;
+    return got;
+  }
+
+  // Frames until one is acked again (0 = none within max)
+  int recover(int max) {
+    for (int n = 1; n <= max; n++) {
+      if (send()) return n;
+    }
+    return 0;
+  }
+};
+
+static void testHopAcquire() {
+  HopLink l;
+  CHECK(l.recover(TB_HOP_LEN) > 0);   // the boot sweep reaches the parked RX
+  CHECK(!l.tx.searching());
+  CHECK(l.rx.locked());
+  for (int i = 0; i < 50; i++) CHECK(l.send());
+}
+
+static void testHopLostAck() {
+  HopLink l;
+  l.recover(TB_HOP_LEN);
+  CHECK(l.send(false, true));
+  CHECK(l.send());   // same slot on both ends, no retry needed
+  CHECK(l.send(false, true));
+  CHECK(l.send());
+}
+
+static void testHopLostFrame() {
+  HopLink l;
+  l.recover(TB_HOP_LEN);
+  CHECK(!l.send(true));
+  CHECK(!l.send());  // first guess: lost ACK, own slot
+  CHECK(l.send());   // then the slot the RX still waits on
+  CHECK(!l.send(true));
+  CHECK(l.recover(4) > 0);
+}
+
+static void testHopMixedLosses() {
+  // Lost frame, then the retry that finds the RX loses its ACK
+  HopLink a;
+  a.recover(TB_HOP_LEN);
+  CHECK(!a.send(true));
+  CHECK(!a.send());
+  CHECK(a.send(false, true));
+  CHECK(a.recover(4) > 0);
+
+  // Lost ACK twice in a row
+  HopLink b;
+  b.recover(TB_HOP_LEN);
+  CHECK(b.send(false, true));
+  CHECK(b.send(false, true));
+  CHECK(b.recover(4) > 0);
+  for (int i = 0; i < 20; i++) CHECK(b.send());
+}
+
+static void testHopCoastAndRelock() {
+  HopLink l;
+  l.recover(TB_HOP_LEN);
+  // 200 ms of nothing: both ends coast the same way
+  for (int i = 0; i < 10; i++) l.send(true);
+  CHECK(l.recover(2) > 0);
+  // Long enough to lose the link: the RX parks, the TX sweeps
+  for (int i = 0; i < 25; i++) l.send(true);
+  CHECK(!l.rx.locked());
+  CHECK(l.tx.searching());
+  CHECK(l.recover(2 * TB_HOP_LEN) > 0);
+  CHECK(l.rx.locked());
+}
+
+static void testHopMaskChange() {
+  HopLink l;
+  l.recover(TB_HOP_LEN);
+  const uint16_t mask = (1u << 2) | (1u << 9);
+  l.tx.stageMask(mask);
+  l.rx.setMask(mask);   // the RX takes TB_HOP_CFG on receipt
+  CHECK(l.send());
+  CHECK_EQ(l.tx.plan().mask(), mask);
+  for (int i = 0; i < 40; i++) CHECK(l.send());
+}
+
+int main() {
+  testCrcKnownAnswer();
+  testCrcBackendsAgree();
+  testCrcNibbleTable();
+  benchCrcBackends();
+  testLittleEndian();
+  testAckPagesFit();
+  testHopPlan();
+  testHopSlotForSeq();
+  testHopAcquire();
+  testHopLostAck();
+  testHopLostFrame();
+  testHopMixedLosses();
+  testHopCoastAndRelock();
+  testHopMaskChange();
+  return TbCheckReport("test_protocol");
+}
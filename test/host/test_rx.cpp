@@ -0,0 +1,768 @@
+// RX sketch pieces on the host: frame parsing (+ legacy parser cross-check),
+// ADC filters (+ trace replay through the ISR chain), conversion tables,
+// actuator registers, failsafe staging, motion interpolation, seq tracking, hop
+// following, compact CMD decoding, ACK queueing (read back with the TX's
+// TbAckPagedView), flight recorder dump.
+// The sketch is compiled as-is against shim/ (its setup()/loop() are unused).
+#include <Arduino.h>
+#include <algorithm>
+#include <string>
+#include <vector>
+#include "../../TugbotFeb21RXGood/TugbotFeb21RXGood.cpp"
+#include "tb_check.h"
+
+static uint8_t buildFrame(uint8_t* f, uint8_t type, uint8_t seq, const uint8_t* pay, uint8_t payLen) {
+  f[0] = TB_VER;
+  f[1] = type;
+  f[2] = 0;
+  f[3] = seq;
+  f[4] = payLen;
+  if (payLen) memcpy(f + TB_HDR_LEN, pay, payLen);
+  const uint8_t noCrc = (uint8_t)(TB_HDR_LEN + payLen);
+  const uint16_t crc = TbCrc16Ccitt(f, noCrc);
+  f[noCrc] = (uint8_t)crc;
+  f[noCrc + 1] = (uint8_t)(crc >> 8);
+  return (uint8_t)(noCrc + TB_CRC_LEN);
+}
+
+static void testFrameView() {
+  const uint8_t cmd[TB_CMD_LEN] = { 40, (uint8_t)-25, 10, 20, 30, 40, 1 };
+  uint8_t f[TB_MAX_AIR];
+  const uint8_t n = buildFrame(f, TB_CMD, 7, cmd, TB_CMD_LEN);
+
+  TbFrameView fv;
+  CHECK_EQ(fv.parse(f, n), TB_S_OK);
+  CHECK_EQ(fv.type(), TB_CMD);
+  CHECK_EQ(fv.seq(), 7);
+  CHECK_EQ(fv.len(), TB_CMD_LEN);
+  const TbCmdView cv(fv.payload());
+  CHECK_EQ(cv.throttlePct(), 40);
+  CHECK_EQ(cv.rudderPct(), -25);
+  CHECK_EQ(cv.acc(3), 40);
+  CHECK_EQ(cv.arm(), 1);
+
+  uint8_t g[TB_MAX_AIR];
+  memcpy(g, f, n);
+  g[TB_HDR_LEN + 3] ^= 0x40;
+  CHECK_EQ(fv.parse(g, n), TB_S_BAD_CRC);
+  memcpy(g, f, n);
+  g[n - 1] ^= 0x01;
+  CHECK_EQ(fv.parse(g, n), TB_S_BAD_CRC);
+  memcpy(g, f, n);
+  g[0] = 1;
+  CHECK_EQ(fv.parse(g, n), TB_S_BAD_VER);
+  CHECK_EQ(fv.parse(f, (uint8_t)(n - 1)), TB_S_BAD_LEN);
+  memcpy(g, f, n);
+  g[4] = 40;
+  CHECK_EQ(fv.parse(g, n), TB_S_BAD_LEN);
+  CHECK_EQ(fv.parse(f, 4), TB_S_BAD_LEN);
+
+  const uint8_t np = buildFrame(f, TB_PING, 8, nullptr, 0);
+  CHECK_EQ(fv.parse(f, np), TB_S_OK);
+  CHECK_EQ(fv.len(), 0);
+}
+
+// Previous memcpy-based parser (TbParseFrame), kept here to cross-check TbFrameView
+static TbStatus legacyParseFrame(const uint8_t* frame, uint8_t frameLen,
+                                 TbHdr& outHdr, const uint8_t*& outPayload, uint8_t& outPayLen) {
+  if (frameLen < TB_HDR_LEN + TB_CRC_LEN) return TB_S_BAD_LEN;
+
+  memcpy(&outHdr, frame, TB_HDR_LEN);
+  if (outHdr.ver != TB_VER) return TB_S_BAD_VER;
+
+  const uint8_t expected = (uint8_t)(TB_HDR_LEN + outHdr.len + TB_CRC_LEN);
+  if (expected != frameLen) return TB_S_BAD_LEN;
+  if (outHdr.len > TB_MAX_PAY) return TB_S_BAD_LEN;
+
+  const uint8_t totalNoCrc = (uint8_t)(TB_HDR_LEN + outHdr.len);
+  const uint16_t got = (uint16_t)frame[totalNoCrc + 0] | ((uint16_t)frame[totalNoCrc + 1] << 8);
+  if (got != TbCrc16Ccitt(frame, totalNoCrc)) return TB_S_BAD_CRC;
+
+  outPayload = frame + TB_HDR_LEN;
+  outPayLen  = outHdr.len;
+  return TB_S_OK;
+}
+
+// Old and new parse paths on good and corrupted frames: same status, same
+// command fields; then host time per frame for each
+static void testFrameViewMatchesLegacy() {
+  static constexpr uint8_t N = 8;
+  uint8_t frames[N][TB_MAX_AIR];
+  uint8_t lens[N];
+  const uint8_t cmdPay[TB_CMD_LEN] = { 40, (uint8_t)-25, 10, 20, 30, 40, 1 };
+  for (uint8_t k = 0; k < N; k++) {
+    lens[k] = k == 1 ? buildFrame(frames[k], TB_PING, (uint8_t)(k + 1), nullptr, 0)
+                     : buildFrame(frames[k], TB_CMD, (uint8_t)(k + 1), cmdPay, TB_CMD_LEN);
+  }
+  frames[2][TB_HDR_LEN + 3] ^= 0x40;            // payload bit flip  -> BAD_CRC
+  frames[3][TB_HDR_LEN + TB_CMD_LEN] ^= 0x01;   // CRC byte flip     -> BAD_CRC
+  frames[4][0] = 1;                              // wrong version     -> BAD_VER
+  lens[5] = (uint8_t)(lens[5] - 1);              // truncated         -> BAD_LEN
+  frames[6][4] = 40;                             // len field too big -> BAD_LEN
+  lens[7] = 4;                                   // runt              -> BAD_LEN
+  static const TbStatus kWant[N] = { TB_S_OK, TB_S_OK, TB_S_BAD_CRC, TB_S_BAD_CRC,
+                                     TB_S_BAD_VER, TB_S_BAD_LEN, TB_S_BAD_LEN, TB_S_BAD_LEN };
+
+  static constexpr uint32_t RUNS = 100000;
+  printf("FRAME %s/frame (host) old/new:", kTbHostCycleUnit);
+  for (uint8_t k = 0; k < N; k++) {
+    TbHdr hdr {};
+    const uint8_t* pay = nullptr;
+    uint8_t payLen = 0;
+    TbCmdV1 oldCmd {};
+    const TbStatus oldSt = legacyParseFrame(frames[k], lens[k], hdr, pay, payLen);
+    if (oldSt == TB_S_OK && payLen == TB_CMD_LEN) memcpy(&oldCmd, pay, sizeof(oldCmd));
+
+    TbFrameView fv;
+    const TbStatus newSt = fv.parse(frames[k], lens[k]);
+    CHECK_EQ(newSt, kWant[k]);
+    CHECK_EQ(newSt, oldSt);
+    if (newSt == TB_S_OK) {
+      CHECK_EQ(fv.seq(), hdr.seq);
+      CHECK_EQ(fv.len(), payLen);
+    }
+    if (newSt == TB_S_OK && fv.len() == TB_CMD_LEN) {
+      const TbCmdView cv(fv.payload());
+      CHECK_EQ(cv.throttlePct(), oldCmd.throttlePct);
+      CHECK_EQ(cv.rudderPct(), oldCmd.rudderPct);
+      for (uint8_t i = 0; i < 4; i++) CHECK_EQ(cv.acc(i), oldCmd.acc[i]);
+      CHECK_EQ(cv.arm(), oldCmd.arm);
+    }
+
+    volatile uint8_t sink = 0;
+    uint64_t t0 = TbHostCycles();
+    for (uint32_t r = 0; r < RUNS; r++) {
+      TbHdr h;
+      TbCmdV1 c;
+      if (legacyParseFrame(frames[k], lens[k], h, pay, payLen) == TB_S_OK && payLen == TB_CMD_LEN) {
+        memcpy(&c, pay, sizeof(c));
+        sink = (uint8_t)(sink ^ c.arm);
+      }
+    }
+    const uint64_t oldT = TbHostCycles() - t0;
+    t0 = TbHostCycles();
+    for (uint32_t r = 0; r < RUNS; r++) {
+      TbFrameView v;
+      if (v.parse(frames[k], lens[k]) == TB_S_OK && v.len() == TB_CMD_LEN) {
+        sink = (uint8_t)(sink ^ TbCmdView(v.payload()).arm());
+      }
+    }
+    const uint64_t newT = TbHostCycles() - t0;
+    printf(" %u:%.1f/%.1f", k, (double)oldT / RUNS, (double)newT / RUNS);
+  }
+  printf("\n");
+}
+
+static void testAdcFilter() {
+  AdcChannelFilter med;
+  med.begin({ 1, 0 });
+  med.push(1000);
+  med.push(1000);
+  CHECK_EQ(med.push(4000), 1000);                 // single spike rejected
+  CHECK_EQ(med.push(1000), 1000);
+  med.push(2000);
+  CHECK_EQ(med.push(2000), 2000);                 // a real step passes after two samples
+
+  AdcChannelFilter iir;
+  iir.begin({ 0, 3 });
+  iir.push(0);
+  uint16_t y = 0;
+  for (uint8_t i = 0; i < 8; i++) y = iir.push(2048);
+  CHECK(y > 1300 && y < 1500);                    // 1 - (7/8)^8 = 0.66 of the step
+  for (uint8_t i = 0; i < 200; i++) y = iir.push(2048);
+  CHECK_EQ(y, 2048);                              // Q4 state settles exactly
+}
+
+// ADC trace replay through the ISR chain: AdcEngine::onConversion (x16
+// oversampling, decimation) then tick() (median-3 + IIR). The loop models the
+// free-running ADC: a conversion samples the channel muxed when it started, i.e.
+// before the previous ADC_vect moved the mux, so a slip in _convSlot/_muxSlot
+// shows up as one channel's trace landing in another's output.
+struct TbAdcTrace {
+  std::vector<uint16_t> s;   // raw 10-bit samples, one per conversion of this channel
+  size_t at = 0;
+  uint16_t next() { return s.empty() ? 512 : s[std::min(at++, s.size() - 1)]; }
+};
+
+struct TbAdcReplayOut {
+  std::vector<uint16_t> dec[TB_ADC_CHANNELS];
+  std::vector<uint16_t> filt[TB_ADC_CHANNELS];
+};
+
+static uint8_t adcMuxSlot() {
+  const uint8_t ch = (uint8_t)((ADMUX & 0x07) | ((ADCSRB & _BV(MUX5)) ? 0x08 : 0));
+  for (uint8_t i = 0; i < TB_ADC_CHANNELS; i++) {
+    if ((uint8_t)(kTbAdcPins[i] - A0) == ch) return i;
+  }
+  return 0xFF;
+}
+
+static void replayAdc(TbAdcTrace (&tr)[TB_ADC_CHANNELS], size_t outputs, TbAdcReplayOut& out) {
+  AdcEngine eng;
+  eng.begin();
+  uint8_t cur = adcMuxSlot();
+  uint8_t conv[TB_ADC_CHANNELS] = {0};
+  for (size_t done = 0; done < TB_ADC_CHANNELS;) {
+    CHECK(cur < TB_ADC_CHANNELS);
+    if (cur >= TB_ADC_CHANNELS) return;
+    ADC = tr[cur].next();
+    const uint8_t next = adcMuxSlot();
+    eng.onConversion();
+    if (++conv[cur] == TB_ADC_OS && out.dec[cur].size() < outputs) {
+      conv[cur] = 0;
+      eng.tick(0);
+      out.dec[cur].push_back(eng.raw(cur));
+      out.filt[cur].push_back(eng.value(cur));
+      if (out.dec[cur].size() == outputs) done++;
+    }
+    if (conv[cur] == TB_ADC_OS) conv[cur] = 0;
+    cur = next;
+  }
+}
+
+static uint16_t p2p(const std::vector<uint16_t>& v, size_t from) {
+  uint16_t lo = 0xFFFF, hi = 0;
+  for (size_t i = from; i < v.size(); i++) {
+    lo = std::min(lo, v[i]);
+    hi = std::max(hi, v[i]);
+  }
+  return from < v.size() ? (uint16_t)(hi - lo) : 0;
+}
+
+// Deterministic stand-ins for the bench captures: a level with +-3 LSB of
+// noise, +-4 LSB of 140 Hz square ripple at the ~1.6 kHz per-channel rate, and
+// a full-scale single-sample spike every 250 samples (ESC switching).
+static void synthTrace(TbAdcTrace& t, size_t n, uint16_t level, uint16_t ripple, uint16_t spikeEvery,
+                       size_t stepAt = 0, uint16_t stepTo = 0) {
+  uint32_t lcg = 0x1234567u + level;
+  t.s.resize(n);
+  for (size_t i = 0; i < n; i++) {
+    lcg = lcg * 1664525u + 1013904223u;
+    const int noise = (int)((lcg >> 24) % 7) - 3;
+    const int rip = (int)ripple * (((i * 140u * 2u) / 1603u) & 1u ? 1 : -1);
+    int v = (stepAt && i >= stepAt ? stepTo : level) + noise + rip;
+    if (spikeEvery && i % spikeEvery == spikeEvery - 1u) v = 1023;
+    t.s[i] = (uint16_t)std::min(1023, std::max(0, v));
+  }
+}
+
+static void testAdcReplay() {
+  static const uint16_t kLevel[TB_ADC_CHANNELS] = { 700, 650, 512, 90, 400, 420 };
+  const size_t outputs = 200;
+  TbAdcTrace tr[TB_ADC_CHANNELS];
+  for (uint8_t i = 0; i < TB_ADC_CHANNELS; i++) {
+    synthTrace(tr[i], outputs * TB_ADC_OS, kLevel[i], 4, 250);
+  }
+  synthTrace(tr[TB_ADC_ISYS], outputs * TB_ADC_OS, 512, 4, 250, 100 * TB_ADC_OS, 600);
+
+  TbAdcReplayOut out;
+  replayAdc(tr, outputs, out);
+
+  // Each channel decodes its own trace (levels are far apart, so a pipeline slip
+  // would be obvious)
+  for (uint8_t i = 0; i < TB_ADC_CHANNELS; i++) {
+    CHECK_EQ(out.dec[i].size(), outputs);
+    const uint16_t want = (uint16_t)(kLevel[i] << TB_ADC_EXTRA_BITS);
+    CHECK(abs((int)out.filt[i][90] - (int)want) <= 8);
+  }
+
+  // Oversampling shrinks a spike to ~1/16, the median drops the rest, the IIR
+  // takes out the noise
+  const size_t settled = 32;
+  const uint16_t pDec = p2p(out.dec[TB_ADC_VSYS], settled);
+  const uint16_t pFilt = p2p(out.filt[TB_ADC_VSYS], settled);
+  CHECK(pDec >= 60);
+  CHECK(pFilt * 4 <= pDec);
+  CHECK(pFilt <= 8);
+
+  // ISYS step 2048 -> 2400 adc12: no overshoot, within 1% after 20 outputs (~200 ms)
+  const std::vector<uint16_t>& is = out.filt[TB_ADC_ISYS];
+  uint16_t peak = 0;
+  for (size_t i = 100; i < outputs; i++) peak = std::max(peak, is[i]);
+  CHECK(peak <= 2400 + 16);
+  CHECK(abs((int)is[120] - 2400) <= 24);
+  CHECK(abs((int)is[outputs - 1] - 2400) <= 8);
+
+  printf("ADC replay (VSYS adc12 p2p after settling): dec=%u filt=%u\n", pDec, pFilt);
+}
+
+// TB_ADC_TRACE=<slot>:<file> replays a captured trace of raw 10-bit samples (one
+// per line, e.g. analogRead logged at ~1.6 kHz) on that slot and prints
+// "dec,filt" per output plus the spread before/after; the other slots idle at
+// mid-scale.
+static void replayAdcTraceFile(const char* spec) {
+  const char* colon = strchr(spec, ':');
+  const int slot = atoi(spec);
+  if (!colon || slot < 0 || slot >= TB_ADC_CHANNELS) {
+    printf("TB_ADC_TRACE: want <slot 0..5>:<file>\n");
+    return;
+  }
+  FILE* fp = fopen(colon + 1, "r");
+  if (!fp) {
+    printf("TB_ADC_TRACE: cannot open %s\n", colon + 1);
+    return;
+  }
+  TbAdcTrace tr[TB_ADC_CHANNELS];
+  char line[32];
+  while (fgets(line, sizeof(line), fp)) {
+    if (line[0] >= '0' && line[0] <= '9') tr[slot].s.push_back((uint16_t)std::min(1023, atoi(line)));
+  }
+  fclose(fp);
+
+  TbAdcReplayOut out;
+  const size_t outputs = tr[slot].s.size() / TB_ADC_OS;
+  if (outputs) replayAdc(tr, outputs, out);
+  for (size_t i = 0; i < out.dec[slot].size(); i++) printf("%u,%u\n", out.dec[slot][i], out.filt[slot][i]);
+  printf("TB_ADC_TRACE: outputs=%zu", outputs);
+  if (outputs > 16) printf(" p2p_dec=%u p2p_filt=%u", p2p(out.dec[slot], 16), p2p(out.filt[slot], 16));
+  printf(" (adc12 counts)\n");
+}
+
+// Double-precision model of the sampler's original float conversions
+static double refNtcC(uint16_t adc12) {
+  const double rNtc = TbCal::T_RSERIES * ((double)TbCal::ADC12_MAX / adc12 - 1.0);
+  const double invT = 1.0 / TbCal::T0_K + log(rNtc / TbCal::T_R0) / TbCal::T_BETA;
+  return 1.0 / invT - 273.15;
+}
+
+static void testConversions() {
+  double errC = 0, errWideC = 0, errMv = 0;
+  int16_t prevC = -32768;
+  uint16_t backwards = 0;
+  for (uint16_t a = 1; a < TB_ADC12_MAX; a++) {
+    const double mv = (double)a * (TbCal::VREF_CAL / TbCal::ADC12_SPAN) * TbCal::VDIV_GAIN * 1000.0;
+    errMv = std::max(errMv, fabs((double)TbBatteryMilliVolts(a) - mv));
+
+    // Full range, including the codes interpolated against the clamped end entries
+    const double ref = refNtcC(a);
+    int16_t cC = 0;
+    CHECK(TbNtcCentiC(a, cC));
+    if (cC < prevC) backwards++;
+    prevC = cC;
+    const double dc = fabs(cC / 100.0 - ref);
+    if (ref >= -40.0 && ref <= 110.0) errC = std::max(errC, dc);
+    if (ref >= -55.0 && ref <= 150.0) errWideC = std::max(errWideC, dc);
+    if (ref > 150.0) CHECK(cC >= 15000);          // hot end never reads cool
+  }
+  int16_t cC = 0;
+  CHECK(TbNtcCentiC(1, cC));
+  CHECK(fabs(cC / 100.0 - refNtcC(1)) <= 10.0);    // cold rail: coarse, but no wrap
+  CHECK(TbNtcCentiC(TB_ADC12_MAX - 1, cC));
+  CHECK(cC > 30000);                                // hot rail: toward the saturated entry, no wrap
+  CHECK(!TbNtcCentiC(0, cC));
+  CHECK(!TbNtcCentiC(TB_ADC12_MAX, cC));
+  CHECK_EQ(backwards, 0);
+  CHECK(errMv <= 1.0);
+  CHECK(errC <= 0.05);
+  CHECK(errWideC <= 0.3);
+}
+
+static void testActuatorOutputs() {
+  ActuatorOutputs out;
+  out.begin();
+  CHECK(TCCR3A & _BV(COM3A1));
+  CHECK(TCCR2A & _BV(COM2A1));
+
+  out.setDuty(ActuatorOutputs::CH_ACC1, 77);
+  out.setDuty(ActuatorOutputs::CH_ACC2, 88);
+  out.setDuty(ActuatorOutputs::CH_ACC4, 99);
+  CHECK_EQ(OCR3B, 77);
+  CHECK_EQ(OCR3A, 88);
+  CHECK_EQ(OCR2A, 99);
+
+  OCR3B = 0;                                      // write-on-change: same duty leaves hardware alone
+  out.setDuty(ActuatorOutputs::CH_ACC1, 77);
+  CHECK_EQ(OCR3B, 0);
+
+  out.setEnable(true);
+  CHECK_EQ(PORTA & (_BV(PA1) | _BV(PA3)), _BV(PA1) | _BV(PA3));
+  out.setEnable(false);
+  CHECK_EQ(PORTA & (_BV(PA1) | _BV(PA3)), 0);
+}
+
+// Event-driven TX: 20 ms frames while the stick moves, then the heartbeat
+static void testFailsafeHeartbeat() {
+  Failsafe fs;
+  g_hostUs = 0;
+  fs.begin(TB_FAILSAFE_MS);
+  TbCmdV1 cmd {};
+  cmd.arm = 1;
+  cmd.throttlePct = 50;
+
+  uint8_t seq = 0;
+  uint32_t ms = 0, lastTx = 0;
+  TbFsStage worst = TB_FS_OK;
+  auto run = [&](uint32_t untilMs, uint32_t periodMs, bool send) {
+    uint32_t nextTx = ms;
+    for (; ms < untilMs; ms += 5) {
+      if (send && ms >= nextTx) {
+        fs.noteFrame(seq++, ms);
+        fs.noteCommand(cmd, ms);
+        lastTx = ms;
+        nextTx += periodMs;
+      }
+      fs.update(ms);
+      if (ms > 200 && fs.stage() > worst) worst = fs.stage();
+    }
+  };
+
+  run(1000, TB_TX_MIN_INTERVAL_MS, true);
+  run(2000, TB_TX_HEARTBEAT_MS, true);
+  CHECK_EQ(worst, TB_FS_OK);                       // stick stop is not a loss
+  CHECK_EQ(fs.throttleScaleQ8(), 256);
+
+  seq++;                                            // heartbeat due now is lost, retried 20 ms later
+  run(ms + TB_TX_MIN_INTERVAL_MS, TB_TX_MIN_INTERVAL_MS, false);
+  run(3000, TB_TX_HEARTBEAT_MS, true);
+  CHECK_EQ(worst, TB_FS_OK);
+
+  seq += 2;                                         // two frames lost mid-stream
+  run(3100, TB_TX_MIN_INTERVAL_MS, true);
+  CHECK_EQ(worst, TB_FS_HOLD);                      // seq gap seen at once, no NEUTRAL
+  run(3200, TB_TX_MIN_INTERVAL_MS, true);
+  CHECK_EQ(fs.stage(), TB_FS_OK);
+
+  uint32_t holdAt = 0, rampAt = 0, neutralAt = 0;
+  for (; ms < 4000; ms += 5) {
+    fs.update(ms);
+    if (!holdAt && fs.stage() >= TB_FS_HOLD) holdAt = ms - lastTx;
+    if (!rampAt && fs.stage() >= TB_FS_RAMP) rampAt = ms - lastTx;
+    if (!neutralAt && fs.stage() == TB_FS_NEUTRAL) neutralAt = ms - lastTx;
+  }
+  CHECK(holdAt >= 140 && holdAt <= 150);
+  CHECK(rampAt >= 160 && rampAt <= 170);
+  CHECK(neutralAt >= 180 && neutralAt <= 190);
+}
+
+// Dead link after an idle heartbeat: each stage vs the single TB_FAILSAFE_MS cliff
+static void testFailsafeBeatsCliff() {
+  Failsafe fs;
+  g_hostUs = 0;
+  fs.begin(TB_FAILSAFE_MS);
+  TbCmdV1 cmd {};
+  cmd.arm = 1;
+  cmd.throttlePct = 60;
+  uint8_t seq = 0;
+  uint32_t ms = 0;
+  for (; ms < 1000; ms += TB_TX_HEARTBEAT_MS) {
+    fs.noteFrame(seq++, ms);
+    fs.noteCommand(cmd, ms);
+    fs.update(ms);
+  }
+  const uint32_t lastMs = ms - TB_TX_HEARTBEAT_MS;
+  CHECK_EQ(fs.stage(), TB_FS_OK);
+
+  uint32_t rampAt = 0, neutralAt = 0;
+  for (ms = lastMs; ms <= lastMs + TB_FAILSAFE_MS; ms++) {
+    fs.update(ms);
+    if (!rampAt && fs.stage() == TB_FS_RAMP) rampAt = ms - lastMs;
+    if (!neutralAt && fs.stage() == TB_FS_NEUTRAL) neutralAt = ms - lastMs;
+  }
+  CHECK(rampAt > TB_TX_HEARTBEAT_MS);               // not before the heartbeat could be due
+  CHECK(neutralAt > rampAt);
+  CHECK(neutralAt * 2 < TB_FAILSAFE_MS);            // under half the old cliff
+  CHECK_EQ(fs.commandToApply(ms).arm, 0);
+}
+
+// Stick ramp at the 20 ms event rate, then only heartbeats: no overshoot
+static void testMotionStickStop() {
+  MotionStage m;
+  m.begin(0);
+  TbCmdV1 cmd {};
+  cmd.arm = 1;
+  uint32_t ms = 0;
+  int16_t peak = 0;
+  for (int8_t pct = 0; pct <= 50; pct += 5) {
+    cmd.throttlePct = pct;
+    m.noteCommand(cmd, ms);
+    const uint32_t next = ms + (pct < 50 ? TB_TX_MIN_INTERVAL_MS : TB_TX_HEARTBEAT_MS);
+    for (; ms < next; ms++) peak = max(peak, m.sample(MotionStage::AX_THROTTLE, ms));
+  }
+  for (uint8_t hb = 0; hb < 10; hb++, ms += TB_TX_HEARTBEAT_MS) {
+    m.noteCommand(cmd, ms);
+    for (uint32_t t = ms; t < ms + TB_TX_HEARTBEAT_MS; t++) peak = max(peak, m.sample(MotionStage::AX_THROTTLE, t));
+  }
+  CHECK_EQ(peak, 50 * 256);
+  CHECK_EQ(m.sample(MotionStage::AX_THROTTLE, ms), 50 * 256);
+  CHECK(m.periodMs() < TB_TX_HEARTBEAT_MS / 2);    // heartbeats do not stretch the ramp period
+}
+
+// Frames lost mid-ramp: hold through the heartbeat bound, then coast and fade
+static void testMotionDropout() {
+  MotionStage m;
+  m.begin(0);
+  TbCmdV1 cmd {};
+  cmd.arm = 1;
+  uint32_t ms = 0;
+  for (int8_t pct = 0; pct <= 40; pct += 4, ms += TB_TX_MIN_INTERVAL_MS) {
+    cmd.throttlePct = pct;
+    m.noteCommand(cmd, ms);
+  }
+  const uint32_t last = ms - TB_TX_MIN_INTERVAL_MS;
+  CHECK_EQ(m.sample(MotionStage::AX_THROTTLE, last + TB_MOTION_HOLD_MS), 40 * 256);
+  CHECK(!m.coasting(last + TB_MOTION_HOLD_MS));
+  CHECK(m.sample(MotionStage::AX_THROTTLE, last + TB_MOTION_HOLD_MS + TB_MOTION_EXTRAP_MS) > 40 * 256);
+  CHECK(m.coasting(last + TB_MOTION_HOLD_MS + 1));
+  CHECK_EQ(m.sample(MotionStage::AX_THROTTLE, last + TB_FAILSAFE_MS), 0);
+}
+
+static void testSeqInOrderAndWrap() {
+  SeqTracker t;
+  uint32_t ms = 0;
+  CHECK_EQ(t.note(200, ms), TB_SEQ_RESYNC);
+  for (uint16_t i = 1; i < 600; i++) CHECK_EQ(t.note((uint8_t)(200 + i), ms += 20), TB_SEQ_NEW);
+  RxStats s {};
+  t.fill(s);
+  CHECK_EQ(s.seqLost, 0);
+  CHECK_EQ(s.seqDups, 0);
+  CHECK_EQ(s.seqReorders, 0);
+  CHECK_EQ(s.seqLossHist[0], 100);
+  CHECK_EQ(t.extSeq(), 200 + 599);
+}
+
+static void testSeqDupLateLoss() {
+  SeqTracker t;
+  uint32_t ms = 0;
+  for (uint8_t i = 0; i < 10; i++, ms += 20) t.note(i, ms);
+  CHECK_EQ(t.note(9, ms), TB_SEQ_DUP);
+  CHECK_EQ(t.note(12, ms += 20), TB_SEQ_NEW);     // 10, 11 missing for now
+  CHECK_EQ(t.note(10, ms += 20), TB_SEQ_LATE);    // reorder: counted, not applied
+  CHECK_EQ(t.note(10, ms += 20), TB_SEQ_DUP);
+  for (uint8_t i = 13; i < 120; i++, ms += 20) t.note(i, ms);
+  RxStats s {};
+  t.fill(s);
+  CHECK_EQ(s.seqLost, 1);                          // only 11 never arrived
+  CHECK_EQ(s.seqDups, 2);
+  CHECK_EQ(s.seqReorders, 1);
+}
+
+// A dropout long enough for the TX seq to move more than 127 (50 Hz plus
+// control frames) must not leave every later frame judged stale
+static void testSeqJumpPastHalfRange() {
+  SeqTracker t;
+  uint32_t ms = 0;
+  uint8_t seq = 0;
+  for (uint8_t i = 0; i < 100; i++) t.note(seq++, ms += 20);
+  for (uint16_t dropMs : { 1200, 2600, 3000 }) {
+    const uint16_t sent = dropMs / TB_TX_MIN_INTERVAL_MS + 5;   // CMDs + a few control frames
+    seq = (uint8_t)(seq + sent);
+    ms += dropMs;
+    CHECK(t.note(seq++, ms) != TB_SEQ_LATE);
+    for (uint8_t i = 0; i < 20; i++) CHECK_EQ(t.note(seq++, ms += 20), TB_SEQ_NEW);
+  }
+  // sent > 127 in under the resync time would alias backwards: three stale
+  // frames in a row resync instead of dropping commands for good
+  seq = (uint8_t)(seq + 200);
+  ms += 500;
+  uint8_t late = 0;
+  TbSeqVerdict v = TB_SEQ_LATE;
+  while (v == TB_SEQ_LATE && late < 10) {
+    v = t.note(seq++, ms += 20);
+    if (v == TB_SEQ_LATE) late++;
+  }
+  CHECK_EQ(v, TB_SEQ_RESYNC);
+  CHECK_EQ(late, TB_SEQ_RESYNC_STALE - 1);
+  CHECK_EQ(t.note(seq++, ms += 20), TB_SEQ_NEW);
+}
+
+// TX reboot mid-run: seq restarts at 0 well behind the newest seen
+static void testSeqTxRestart() {
+  SeqTracker t;
+  Failsafe fs;
+  g_hostUs = 0;
+  fs.begin(TB_FAILSAFE_MS);
+  TbCmdV1 cmd {};
+  cmd.arm = 1;
+  uint32_t ms = 0;
+  uint8_t seq = 0;
+  auto frame = [&](uint8_t s) {
+    const TbSeqVerdict v = t.note(s, ms);
+    if (v != TB_SEQ_DUP) fs.noteFrame(s, ms, v == TB_SEQ_RESYNC);
+    if (v == TB_SEQ_NEW || v == TB_SEQ_RESYNC) fs.noteCommand(cmd, ms);
+    fs.update(ms);
+    return v;
+  };
+  for (uint8_t i = 0; i < 110; i++, ms += 20) frame(seq++);
+  CHECK_EQ(fs.stage(), TB_FS_OK);
+
+  ms += 400;                       // reboot + radio bring-up
+  seq = 0;
+  uint8_t applied = 0;
+  for (uint8_t i = 0; i < 20; i++, ms += 20) {
+    const TbSeqVerdict v = frame(seq++);
+    if (v == TB_SEQ_NEW || v == TB_SEQ_RESYNC) applied++;
+  }
+  CHECK_EQ(applied, 20 - (TB_SEQ_RESYNC_STALE - 1));
+  CHECK_EQ(fs.stage(), TB_FS_OK);
+}
+
+static bool ackStatus(const std::vector<uint8_t>& a, uint8_t& status) {
+  TbAckPagedView v;
+  if (!v.parse(a.data(), (uint8_t)a.size())) return false;
+  status = v.status();
+  return true;
+}
+
+// Each read frame moves the RX onto the hop slot of the next seq
+static void testHopFollowsSeq() {
+  static RxRadioLink link;
+  g_hostUs = 1000000;
+  radio.rx.clear();
+  radio.ack.clear();
+  CHECK(link.begin());
+  TbHopPlan plan;
+  plan.begin(TB_HOP_SEED);
+
+  // Consecutive seqs, gaps and the 255 -> 0 wrap
+  const uint8_t seqs[] = { 5, 6, 9, 10, 255, 0 };
+  for (uint8_t i = 0; i < sizeof(seqs); i++) {
+    const uint8_t cmd[TB_CMD_LEN] = { 10, 0, 0, 0, 0, 0, 1 };
+    uint8_t f[TB_MAX_AIR];
+    const uint8_t n = buildFrame(f, TB_CMD, seqs[i], cmd, TB_CMD_LEN);
+    radio.rx.emplace_back(f, f + n);
+    g_hostUs += 60000;                                // past the safety poll, inside the coast
+    uint8_t seq = 0;
+    TbStatus st = TB_S_BAD_LEN;
+    TbCmdV1 out {};
+    bool hasCmd = false;
+    CHECK(link.poll(seq, st, out, hasCmd));
+    CHECK_EQ(seq, seqs[i]);
+    CHECK_EQ(radio.channel, plan.channel(plan.slotForSeq((uint8_t)(seqs[i] + 1))));
+  }
+  radio.ack.clear();
+}
+
+// Compact CMD: acc[] only on ACC frames, held between them
+static void testCompactCmd() {
+  static RxRadioLink link;
+  g_hostUs = 2000000;
+  radio.rx.clear();
+  CHECK(link.begin());
+
+  const uint8_t acc[TB_CMDC_ACC_LEN] = { 11, 22, 33, 44 };
+  for (uint8_t i = 0; i < 3; i++) {
+    const bool withAcc = i == 1;
+    uint8_t f[TB_MAX_AIR];
+    uint8_t n = 0;
+    f[n++] = (uint8_t)(TB_CMDC_TAG | TB_CMDC_F_ARM | (withAcc ? TB_CMDC_F_ACC : 0));
+    f[n++] = (uint8_t)(20 + i);
+    f[n++] = (uint8_t)(int8_t)(10 * i);
+    f[n++] = (uint8_t)(int8_t)-30;
+    if (withAcc) {
+      memcpy(f + n, acc, TB_CMDC_ACC_LEN);
+      n += TB_CMDC_ACC_LEN;
+    }
+    const uint16_t crc = TbCrc16Ccitt(f, n);
+    f[n++] = (uint8_t)crc;
+    f[n++] = (uint8_t)(crc >> 8);
+    CHECK_EQ(n, withAcc ? 10 : 6);
+    radio.rx.emplace_back(f, f + n);
+
+    g_hostUs += 60000;
+    uint8_t seq = 0;
+    TbStatus st = TB_S_BAD_LEN;
+    TbCmdV1 out {};
+    bool hasCmd = false;
+    CHECK(link.poll(seq, st, out, hasCmd));
+    CHECK_EQ(st, TB_S_OK);
+    CHECK(hasCmd);
+    CHECK_EQ(seq, 20 + i);
+    CHECK_EQ(out.throttlePct, 10 * i);
+    CHECK_EQ(out.rudderPct, -30);
+    CHECK_EQ(out.arm, 1);
+    CHECK_EQ(out.acc[2], i == 0 ? 0 : 33);              // 0 until the first ACC frame
+  }
+  radio.ack.clear();
+}
+
+// Flag edges patch the queued ACK only while it is still in the TX FIFO
+static void testAckStatusRewrite() {
+  RxRadioLink link;
+  Telemetry tel {};
+  RxStats stats {};
+  uint8_t st = 0;
+  radio.ack.clear();
+
+  link.queueAck(1, TB_S_OK, tel, stats);
+  link.setStatusFlags(TB_S_F_WATER);
+  CHECK_EQ(radio.ack.size(), 1);
+  CHECK(ackStatus(radio.ack.front(), st));
+  CHECK_EQ(st, TB_S_F_WATER);
+
+  radio.ack.pop_front();                              // taken by a frame not yet read
+  link.setStatusFlags(TB_S_F_WATER | TB_S_F_WATER_SEEN);
+  CHECK_EQ(radio.ack.size(), 0);
+  link.queueAck(2, TB_S_OK, tel, stats);
+  CHECK_EQ(radio.ack.size(), 1);                      // no stale copy ahead of it
+  CHECK(ackStatus(radio.ack.front(), st));
+  CHECK_EQ(st, TB_S_F_WATER | TB_S_F_WATER_SEEN);
+  CHECK_EQ(radio.ack.front()[offsetof(TbAckPagedHdr, seqEcho)], 2);
+  radio.ack.clear();
+}
+
+struct CapturePrint : Print {
+  std::string text;
+  size_t write(uint8_t c) override { text += (char)c; return 1; }
+};
+
+static void testFlightRecorderDump() {
+  static FlightRecorder rec;
+  rec.begin(0);
+  for (uint32_t i = 1; i <= 40; i++) {
+    TbRecSample s {};
+    s.v[TB_REC_THR] = (uint16_t)(int16_t)(i < 20 ? 50 : -30);
+    s.v[TB_REC_VSYS] = (uint16_t)(12000 - i);
+    s.v[TB_REC_RXOK] = (uint16_t)(i * 5);
+    rec.record(i * TB_REC_PERIOD_MS, s);
+  }
+  CHECK_EQ(rec.records(), 40u);
+
+  // One line per call: header, columns, 40 records, end marker
+  rec.dumpBegin();
+  CHECK(rec.frozen());
+  std::vector<std::string> lines;
+  for (int calls = 0; rec.dumping() && calls < 100; calls++) {
+    CapturePrint out;
+    rec.dumpNext(out);
+    CHECK_EQ(std::count(out.text.begin(), out.text.end(), '\n'), 1);
+    lines.push_back(out.text);
+  }
+  CHECK(!rec.dumping());
+  CHECK_EQ(lines.size(), 43u);
+  CHECK(lines[0].rfind("REC reason=5 ", 0) == 0);
+  CHECK(lines[1].rfind("t_ms,thr,", 0) == 0);
+  CHECK(lines[2] == "100,50,0,0,11999,0,0,0,0,0,5,0,0\r\n");
+  CHECK(lines[41] == "4000,-30,0,0,11960,0,0,0,0,0,200,0,0\r\n");
+  CHECK(lines[42] == "REC end\r\n");
+
+  // Frozen while dumping: new samples do not move the ring under the cursor
+  rec.dumpBegin();
+  TbRecSample s {};
+  rec.record(5000, s);
+  CHECK_EQ(rec.records(), 40u);
+  rec.resume(5000);
+  CHECK(!rec.dumping());
+}
+
+int main() {
+  testFrameView();
+  testFrameViewMatchesLegacy();
+  testAdcFilter();
+  testAdcReplay();
+  if (const char* trace = getenv("TB_ADC_TRACE")) replayAdcTraceFile(trace);
+  testConversions();
+  testActuatorOutputs();
+  testFailsafeHeartbeat();
+  testFailsafeBeatsCliff();
+  testMotionStickStop();
+  testMotionDropout();
+  testSeqInOrderAndWrap();
+  testSeqDupLateLoss();
+  testSeqJumpPastHalfRange();
+  testSeqTxRestart();
+  testHopFollowsSeq();
+  testCompactCmd();
+  testAckStatusRewrite();
+  testFlightRecorderDump();
+  return TbCheckReport("test_rx");
+}